@@ -7,29 +7,36 @@
 #include <sstream>
 #include "globals.h"
 #include "validations.h"
+#include "parallel_load.h"
 
 
 Appointment::Appointment(int id, int ownerId, int petId, const std::string& date, const std::string& time, const std::string& purpose, const std::string& status) 
-        : appointmentId(id), ownerId(ownerId), petId(petId), date(date), time(time), purpose(purpose), status(status) {}
+        : appointmentId(id), ownerId(ownerId), petId(petId), date(date), time(time), purpose(purpose), status(Symbol(status)) {}
+
+Appointment::Appointment(int id, int ownerId, int petId, StoredDate date, StoredTime time, std::string purpose, std::string_view status)
+        : appointmentId(id), ownerId(ownerId), petId(petId), date(date), time(time), purpose(std::move(purpose)), status(Symbol(status)) {}
 
 
 // getter methods
 int Appointment::getAppointmentId() const {return appointmentId;}
 int Appointment::getOwnerId() const {return ownerId;}
 int Appointment::getPetId() const {return petId;}
-std::string Appointment::getDate() const {return date;}
-std::string Appointment::getTime() const {return time;}
+std::string Appointment::getDate() const {return date.toString();}
+std::string Appointment::getTime() const {return time.toString();}
+Date Appointment::getDateValue() const {return date.value();}
+TimeOfDay Appointment::getTimeValue() const {return time.value();}
 std::string Appointment::getPurpose() const {return purpose;}
-std::string Appointment::getStatus() const {return status;}
+const std::string& Appointment::getStatus() const {return status.str();}
+Symbol Appointment::getStatusSymbol() const {return status;}
 
 // setter methods
 
 void Appointment::setDate(const std::string& newDate) {
-    date = newDate;
+    date = StoredDate(newDate);
 }
 
 void Appointment::setTime(const std::string& newTime) {
-    time = newTime;
+    time = StoredTime(newTime);
 }
 
 void Appointment::setPurpose(const std::string& newPurpose) {
@@ -37,7 +44,7 @@ void Appointment::setPurpose(const std::string& newPurpose) {
 }
 
 void Appointment::setStatus(const std::string& newStatus) {
-    status = newStatus;
+    status = Symbol(newStatus);
 }
 
 
@@ -46,18 +53,18 @@ void Appointment::setOwnerId(int newOwnerId) {
 }
 void Appointment::updateStatus(const std::string& newStatus) {
     if (newStatus == "scheduled" || newStatus == "completed" || newStatus == "cancelled") {
-        status = newStatus;
+        status = Symbol(newStatus);
     } else {
         std::cerr << "Invalid status. Must be 'scheduled', 'completed', or 'cancelled'.\n";
     }
 }
 
 void Appointment::updateDate(const std::string& newDate) { 
-    date = newDate;
+    date = StoredDate(newDate);
 }
 
 void Appointment::updateTime(const std::string& newTime) {
-    time = newTime;
+    time = StoredTime(newTime);
 }
 
 // display
@@ -98,6 +105,13 @@ void Appointment::displayFullAppointment() const {
 }
 
 void Appointment::displayAppointmentsTable(const std::vector<Appointment>& appointments) {
+    AppointmentView all;
+    all.reserve(appointments.size());
+    for (const auto& appt : appointments) all.push_back(&appt);
+    displayAppointmentsTable(all);
+}
+
+void Appointment::displayAppointmentsTable(const AppointmentView& appointments) {
     if (appointments.empty()) {
         std::cout << "📭 No appointments to display.\n";
         return;
@@ -123,8 +137,8 @@ void Appointment::displayAppointmentsTable(const std::vector<Appointment>& appoi
     std::cout << std::string(10 + 10 + 10 + 12 + 8 + purposeWidth + statusWidth, '-') << "\n";
 
     // Rows
-    for (const auto& appt : appointments) {
-        std::string purpose = appt.getPurpose();
+    for (const Appointment* appt : appointments) {
+        std::string purpose = appt->getPurpose();
         std::string displayPurpose;
 
         if ((int)purpose.length() > maxPurposeTextLength) {
@@ -134,13 +148,13 @@ void Appointment::displayAppointmentsTable(const std::vector<Appointment>& appoi
         }
 
         std::cout << std::left
-                  << std::setw(10) << appt.getAppointmentId()
-                  << std::setw(10) << appt.getPetId()
-                  << std::setw(10) << appt.getOwnerId()
-                  << std::setw(12) << appt.getDate()
-                  << std::setw(8)  << appt.getTime()
+                  << std::setw(10) << appt->getAppointmentId()
+                  << std::setw(10) << appt->getPetId()
+                  << std::setw(10) << appt->getOwnerId()
+                  << std::setw(12) << appt->getDate()
+                  << std::setw(8)  << appt->getTime()
                   << std::setw(purposeWidth) << displayPurpose
-                  << std::setw(statusWidth)  << appt.getStatus()
+                  << std::setw(statusWidth)  << appt->getStatus()
                   << "\n";
     }
 
@@ -176,6 +190,13 @@ void Appointment::saveToFile(const std::string& filename) const {
     }
 
     // write appointment data
+    writeToFileStream(file);
+
+    file.close();
+    
+}
+
+void Appointment::writeToFileStream(std::ostream& file) const {
     file << appointmentId << "," 
          << ownerId << "," 
          << petId << "," 
@@ -183,64 +204,74 @@ void Appointment::saveToFile(const std::string& filename) const {
          << time << "," 
          << escapeCommas(purpose) << "," 
          << status << "\n";
-
-    file.close();
-    
 }
 
 
-std::vector<Appointment> Appointment::loadFromFile(const std::string& filename) {
-    std::vector<Appointment> appointments;
-    std::ifstream file(filename);
+std::vector<Appointment> Appointment::loadFromFile(const std::string& filename, int& nextAppointmentId) {
+    MappedFile file(filename);
 
-    if (!file) {
-        std::cerr << "Error. No such file!\n";
-        return appointments;
+    if (!file.isOpen()) {
+        writeLoadLog("Error. No such file!\n");
+        return {};
     }
 
-    std::string line;
-    std::getline(file, line); // skip header
+    std::string_view text = file.view();
+    size_t pos = 0;
+    nextLine(text, pos); // skip header
 
-    while (std::getline(file, line)) {
-        std::stringstream ss(line);
-        std::string idStr, ownerStr, petStr, date, time, restOfLine;
+    return parseCsvBody<Appointment>(text.substr(pos),
+        [](std::string_view line, std::vector<Appointment>& appointments, std::ostream& log, TextArena&) {
+            return parseCsvLine(std::string(line), appointments, log);
+        },
+        [](const Appointment& a) { return a.appointmentId; }, nextAppointmentId, loadedText);
+}
 
-        std::getline(ss, idStr, ',');
-        std::getline(ss, ownerStr, ',');
-        std::getline(ss, petStr, ',');
-        std::getline(ss, date, ',');
-        std::getline(ss, time, ',');
-        std::getline(ss, restOfLine);  // remainder: purpose and status
+bool Appointment::parseCsvLine(const std::string& line, std::vector<Appointment>& appointments, std::ostream& log) {
+    std::stringstream ss(line);
+    std::string idStr, ownerStr, petStr, date, time, restOfLine;
 
-        if (idStr.empty() || ownerStr.empty() || petStr.empty() || restOfLine.empty()) {
-            std::cerr << "Malformed appointment line: " << line << "\n";
-            continue;
-        }
+    std::getline(ss, idStr, ',');
+    std::getline(ss, ownerStr, ',');
+    std::getline(ss, petStr, ',');
+    std::getline(ss, date, ',');
+    std::getline(ss, time, ',');
+    std::getline(ss, restOfLine);  // remainder: purpose and status
 
-        // find last comma — separate purpose and status
-        size_t lastComma = restOfLine.rfind(',');
-        if (lastComma == std::string::npos) {
-            std::cerr << "Malformed line (status missing): " << line << "\n";
-            continue;
-        }
+    if (idStr.empty() || ownerStr.empty() || petStr.empty() || restOfLine.empty()) {
+        log << "Malformed appointment line: " << line << "\n";
+        return false;
+    }
 
-        std::string purposePart = restOfLine.substr(0, lastComma);
-        std::string statusPart = restOfLine.substr(lastComma + 1);
-
-        appointments.emplace_back(
-            std::stoi(idStr),
-            std::stoi(ownerStr),
-            std::stoi(petStr),
-            date, time,
-            unescapeCommas(purposePart),
-            statusPart
-        );
+    // find last comma — separate purpose and status
+    size_t lastComma = restOfLine.rfind(',');
+    if (lastComma == std::string::npos) {
+        log << "Malformed line (status missing): " << line << "\n";
+        return false;
     }
 
-    return appointments;
+    std::string purposePart = restOfLine.substr(0, lastComma);
+    std::string statusPart = restOfLine.substr(lastComma + 1);
+
+    appointments.emplace_back(
+        std::stoi(idStr),
+        std::stoi(ownerStr),
+        std::stoi(petStr),
+        date, time,
+        unescapeCommas(purposePart),
+        statusPart
+    );
+    return true;
 }
 
 Appointment* findAppointmentById(std::vector<Appointment>& appointments, int id) {
+    // The global appointment list is indexed; fall back to a scan for any other
+    if (&appointments == &::appointments) {
+        size_t slot = appointmentIndex.slotOf(id);
+        if (slot < appointments.size() && appointments[slot].getAppointmentId() == id) {
+            return &appointments[slot];
+        }
+    }
+
     for (auto& appt : appointments) {
         if (appt.getAppointmentId() == id) {
             return &appt;
@@ -266,16 +297,18 @@ void Appointment::displayAppointmentsTable(const std::vector<Appointment*>& appt
 
     std::cout << std::string(6 + 12 + 8 + 20 + 35 + 14, '-') << "\n";
 
+    static const Symbol scheduled("scheduled"), completed("completed"), cancelled("cancelled");
     for (const Appointment* appt : appts) {
         const Pet* pet = findPetById(pets, appt->getPetId());
         std::string petName = pet ? pet->getName() : "(Unknown)";
         std::string shortPurpose = truncateDetails(appt->getPurpose(), 34);
 
         std::string statusDisplay;
-        if (appt->getStatus() == "scheduled") statusDisplay = "📅 scheduled";
-        else if (appt->getStatus() == "completed") statusDisplay = "✅ completed";
-        else if (appt->getStatus() == "cancelled") statusDisplay = "❌ cancelled";
-        else statusDisplay = appt->getStatus(); // fallback
+        Symbol status = appt->getStatusSymbol();
+        if (status == scheduled) statusDisplay = "📅 scheduled";
+        else if (status == completed) statusDisplay = "✅ completed";
+        else if (status == cancelled) statusDisplay = "❌ cancelled";
+        else statusDisplay = status.str(); // fallback
 
         std::cout << std::left
                   << std::setw(6)  << appt->getAppointmentId()
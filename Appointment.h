@@ -4,6 +4,9 @@
 #include <iostream>
 #include <string>
 #include <vector>
+#include "AppointmentIndex.h"
+#include "Symbol.h"
+#include "DateTime.h"
 
 class Pet;
 class Owner;
@@ -15,14 +18,15 @@ class Appointment {
     int ownerId;
     int petId;
     // int nextAppointmentId;
-    std::string date;    // Format: YYYY-MM-DD
-    std::string time;    // Format: HH:MM
+    StoredDate date;     // Packed; YYYY-MM-DD in files and on screen (unreadable text kept as is)
+    StoredTime time;     // Packed; HH:MM in files and on screen (unreadable text kept as is)
     std::string purpose; // Reason for appointment: vaccination, check-up, etc.
-    std::string status;  // Appointment status: scheduled, completed, cancelled
+    Symbol status;       // Appointment status: scheduled, completed, cancelled (interned)
 
 public:
     // Constructs an Appointment with specified details.
     Appointment(int id, int ownerId, int petId, const std::string& date, const std::string& time, const std::string& purpose, const std::string& status);
+    Appointment(int id, int ownerId, int petId, StoredDate date, StoredTime time, std::string purpose, std::string_view status);
 
     // Getter methods
     int getAppointmentId() const;           // Returns the appointment ID
@@ -30,8 +34,11 @@ public:
     int getPetId() const;                   // Returns the pet ID
     std::string getDate() const;            // Returns the appointment date
     std::string getTime() const;            // Returns the appointment time
+    Date getDateValue() const;              // The date, for comparing and arithmetic
+    TimeOfDay getTimeValue() const;         // The time, for comparing and arithmetic
     std::string getPurpose() const;         // Returns the purpose of the appointment
-    std::string getStatus() const;          // Returns the status of the appointment
+    const std::string& getStatus() const;   // Returns the status of the appointment
+    Symbol getStatusSymbol() const;         // The status as an interned symbol, for cheap comparisons
 
     // Setter methods for updating individual fields
     void updateStatus(const std::string& newStatus);     // Updates the status
@@ -49,10 +56,15 @@ public:
     void displayAsTableRow() const;                      // Displays one row (compact format)
     void displayFullAppointment() const;                 // Full appointment display for one record
     static void displayAppointmentsTable(const std::vector<Appointment>& appointments); // Table view of multiple appointments
+    static void displayAppointmentsTable(const AppointmentView& appointments);           // Same table over an index view
 
     // File handling methods
     void saveToFile(const std::string& filename) const;                          // Saves this appointment to file
-    static std::vector<Appointment> loadFromFile(const std::string& filename);   // Loads all appointments from file
+    void writeToFileStream(std::ostream& file) const;                            // Writes this appointment as one CSV row
+    // Loads all appointments from file, raising nextAppointmentId past every loaded ID
+    static std::vector<Appointment> loadFromFile(const std::string& filename, int& nextAppointmentId);
+    // Parses one CSV row and appends it; problems are reported to log
+    static bool parseCsvLine(const std::string& line, std::vector<Appointment>& appointments, std::ostream& log = std::cerr);
     static void displayAppointmentsTable(const std::vector<Appointment*>& appts); // Table view from vector of pointers
 };
 
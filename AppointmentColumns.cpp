@@ -0,0 +1,141 @@
+#include "AppointmentColumns.h"
+#include "Appointment.h"
+#include "globals.h"
+#include <algorithm>
+
+// Rows per mask in select()
+static const size_t BLOCK = 64;
+
+// The lower bound actually compared against: excludes rows whose date is INVALID_DAYS
+static int32_t lowerBound(Date from) {
+    return from.valid() ? from.daysSinceEpoch() : Date::INVALID_DAYS + 1;
+}
+
+std::string_view AppointmentColumns::Row::getPurpose() const {
+    return std::string_view(columns->purposeHeap).substr(columns->purposeStart[row], columns->purposeLength[row]);
+}
+
+const std::string& AppointmentColumns::Row::getStatus() const {
+    return symbols.text(columns->statuses[row]);
+}
+
+void AppointmentColumns::rebuild(const std::vector<Appointment>& appointments) {
+    ids.clear();
+    ownerIds.clear();
+    petIds.clear();
+    days.clear();
+    minutes.clear();
+    statuses.clear();
+    purposeStart.clear();
+    purposeLength.clear();
+    purposeHeap.clear();
+    livePurposeBytes = 0;
+    for (size_t i = 0; i < appointments.size(); ++i) set(i, appointments[i]);
+}
+
+void AppointmentColumns::storePurpose(size_t row, const std::string& purpose) {
+    // an unchanged purpose keeps its slice; a changed one is appended
+    if (Row(this, row).getPurpose() == purpose) return;
+    livePurposeBytes -= purposeLength[row];
+    purposeStart[row] = static_cast<uint32_t>(purposeHeap.size());
+    purposeLength[row] = static_cast<uint32_t>(purpose.size());
+    purposeHeap += purpose;
+    livePurposeBytes += purpose.size();
+}
+
+void AppointmentColumns::set(size_t row, const Appointment& appt) {
+    if (row >= ids.size()) {
+        size_t rows = row + 1;
+        ids.resize(rows, 0);
+        ownerIds.resize(rows, 0);
+        petIds.resize(rows, 0);
+        days.resize(rows, Date::INVALID_DAYS);
+        minutes.resize(rows, TimeOfDay::INVALID_MINUTES);
+        statuses.resize(rows, 0);
+        purposeStart.resize(rows, static_cast<uint32_t>(purposeHeap.size()));
+        purposeLength.resize(rows, 0);
+    }
+
+    ids[row] = appt.getAppointmentId();
+    ownerIds[row] = appt.getOwnerId();
+    petIds[row] = appt.getPetId();
+    Date date = appt.getDateValue();
+    TimeOfDay time = appt.getTimeValue();
+    days[row] = date.valid() ? date.daysSinceEpoch() : Date::INVALID_DAYS;
+    minutes[row] = time.valid() ? static_cast<uint16_t>(time.minutesSinceMidnight()) : TimeOfDay::INVALID_MINUTES;
+    statuses[row] = appt.getStatusSymbol().getId();
+    storePurpose(row, appt.getPurpose());
+    compactIfSparse();
+}
+
+void AppointmentColumns::erase(size_t row) {
+    if (row >= ids.size()) return;
+    livePurposeBytes -= purposeLength[row];
+    ids.erase(ids.begin() + row);
+    ownerIds.erase(ownerIds.begin() + row);
+    petIds.erase(petIds.begin() + row);
+    days.erase(days.begin() + row);
+    minutes.erase(minutes.begin() + row);
+    statuses.erase(statuses.begin() + row);
+    purposeStart.erase(purposeStart.begin() + row);
+    purposeLength.erase(purposeLength.begin() + row);
+    compactIfSparse();
+}
+
+void AppointmentColumns::compactIfSparse() {
+    size_t unused = purposeHeap.size() - livePurposeBytes;
+    if (unused < 4096 || unused < livePurposeBytes) return;
+
+    std::string kept;
+    kept.reserve(livePurposeBytes);
+    for (size_t row = 0; row < ids.size(); ++row) {
+        uint32_t start = static_cast<uint32_t>(kept.size());
+        kept.append(purposeHeap, purposeStart[row], purposeLength[row]);
+        purposeStart[row] = start;
+    }
+    purposeHeap = std::move(kept);
+}
+
+std::vector<size_t> AppointmentColumns::select(Symbol status, Date from, Date to) const {
+    std::vector<size_t> rows;
+    if (!to.valid()) return rows;
+    const uint32_t code = status.getId();
+    const int32_t first = lowerBound(from), last = to.daysSinceEpoch();
+    const uint32_t* statusColumn = statuses.data();
+    const int32_t* dayColumn = days.data();
+
+    for (size_t base = 0; base < ids.size(); base += BLOCK) {
+        size_t n = std::min(BLOCK, ids.size() - base);
+
+        // branch-free compare of one block into a bit mask
+        uint64_t mask = 0;
+        for (size_t i = 0; i < n; ++i) {
+            bool hit = (statusColumn[base + i] == code) & (dayColumn[base + i] >= first) & (dayColumn[base + i] < last);
+            mask |= static_cast<uint64_t>(hit) << i;
+        }
+
+        for (; mask; mask &= mask - 1) rows.push_back(base + __builtin_ctzll(mask));
+    }
+    return rows;
+}
+
+size_t AppointmentColumns::count(Symbol status, Date from, Date to) const {
+    if (!to.valid()) return 0;
+    const uint32_t code = status.getId();
+    const int32_t first = lowerBound(from), last = to.daysSinceEpoch();
+    const uint32_t* statusColumn = statuses.data();
+    const int32_t* dayColumn = days.data();
+
+    size_t total = 0;
+    for (size_t i = 0; i < ids.size(); ++i) {
+        total += (statusColumn[i] == code) & (dayColumn[i] >= first) & (dayColumn[i] < last);
+    }
+    return total;
+}
+
+size_t AppointmentColumns::memoryUsage() const {
+    return (ids.capacity() + ownerIds.capacity() + petIds.capacity() + days.capacity()) * sizeof(int32_t)
+         + minutes.capacity() * sizeof(uint16_t)
+         + (statuses.capacity() + purposeStart.capacity() + purposeLength.capacity()) * sizeof(uint32_t)
+         + purposeHeap.capacity();
+}
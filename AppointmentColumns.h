@@ -0,0 +1,80 @@
+#ifndef APPOINTMENTCOLUMNS_H
+#define APPOINTMENTCOLUMNS_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "DateTime.h"
+#include "Symbol.h"
+
+class Appointment;
+
+// Column-wise copy of the appointment vector for scans and reports.
+// Row i mirrors appointments[i]: every field sits in its own contiguous array
+// (IDs, packed date and time, status as its Symbol number), and purposes are
+// slices of one shared text heap. A filter such as "scheduled and dated in
+// this range" then reads two small arrays instead of whole Appointment objects,
+// 64 rows at a time into a bit mask, in a loop the compiler can vectorize.
+// AppointmentIndex keeps it in step with the vector (see
+// AppointmentIndex::columns): a row is only rewritten by AppointmentIndex::add
+// and update, so code that edits an appointment calls update() rather than
+// touching the columns.
+class AppointmentColumns {
+    std::vector<int32_t> ids, ownerIds, petIds;
+    std::vector<int32_t> days;               // Date::daysSinceEpoch(); INVALID_DAYS if unreadable
+    std::vector<uint16_t> minutes;           // TimeOfDay::minutesSinceMidnight(); INVALID_MINUTES if unreadable
+    std::vector<uint32_t> statuses;          // Symbol::getId() of the status
+    std::vector<uint32_t> purposeStart, purposeLength;   // slice of purposeHeap
+    std::string purposeHeap;
+    size_t livePurposeBytes = 0;
+
+    void storePurpose(size_t row, const std::string& purpose);
+    void compactIfSparse();   // drops purpose text no row refers to, once it outweighs the rest
+
+public:
+    // Appointment-like read-only view of one row, for code that lists results
+    class Row {
+        const AppointmentColumns* columns;
+        size_t row;
+
+    public:
+        Row(const AppointmentColumns* columns, size_t row) : columns(columns), row(row) {}
+
+        size_t getRow() const { return row; }
+        int getAppointmentId() const { return columns->ids[row]; }
+        int getOwnerId() const { return columns->ownerIds[row]; }
+        int getPetId() const { return columns->petIds[row]; }
+        Date getDateValue() const { return Date::fromDays(columns->days[row]); }
+        TimeOfDay getTimeValue() const { return TimeOfDay::fromMinutes(columns->minutes[row]); }
+        std::string getDate() const { return getDateValue().toString(); }
+        std::string getTime() const { return getTimeValue().toString(); }
+        std::string_view getPurpose() const;
+        const std::string& getStatus() const;
+    };
+
+    // Replaces the contents with the whole vector
+    void rebuild(const std::vector<Appointment>& appointments);
+
+    // Stores an appointment at a row; row == size() appends
+    void set(size_t row, const Appointment& appt);
+
+    // Drops a row; the rows after it move down by one, like the vector's
+    void erase(size_t row);
+
+    size_t size() const { return ids.size(); }
+    Row row(size_t i) const { return Row(this, i); }
+
+    // Rows with the given status dated in [from, to), in row order. An invalid
+    // `from` means no lower bound; rows with an unreadable date never match.
+    std::vector<size_t> select(Symbol status, Date from, Date to) const;
+
+    // Number of rows select() would return
+    size_t count(Symbol status, Date from, Date to) const;
+
+    // Approximate heap bytes held by the columns
+    size_t memoryUsage() const;
+};
+
+#endif  // APPOINTMENTCOLUMNS_H
@@ -0,0 +1,271 @@
+#include "AppointmentIndex.h"
+#include "Appointment.h"
+#include "globals.h"
+#include "validations.h"
+#include <algorithm>
+
+// Removes the single (key, appointmentId) pair from a multimap
+template <typename Key>
+static void eraseHandle(std::multimap<Key, int>& index, const Key& key, int appointmentId) {
+    auto range = index.equal_range(key);
+    for (auto it = range.first; it != range.second; ++it) {
+        if (it->second == appointmentId) {
+            index.erase(it);
+            return;
+        }
+    }
+}
+
+// Resolves a list of slots against the vector
+template <typename Ptr, typename Vec>
+static std::vector<Ptr> viewOf(Vec& appointments, const std::vector<size_t>& slots) {
+    std::vector<Ptr> view;
+    view.reserve(slots.size());
+    for (size_t slot : slots) {
+        if (slot < appointments.size()) view.push_back(&appointments[slot]);
+    }
+    return view;
+}
+
+long long AppointmentIndex::minuteOf(Date date, TimeOfDay time) {
+    if (!date.valid() || !time.valid()) return NO_TIME;
+    return static_cast<long long>(date.daysSinceEpoch()) * MINUTES_PER_DAY + time.minutesSinceMidnight();
+}
+
+long long AppointmentIndex::minuteOf(const std::string& date, const std::string& time) {
+    return minuteOf(Date::parse(date), TimeOfDay::parse(time));
+}
+
+AppointmentIndex::Keys AppointmentIndex::keysOf(const Appointment& appt, size_t slot) {
+    static const Symbol cancelled("cancelled");
+    return Keys{ slot, appt.getOwnerId(), appt.getPetId(), minuteOf(appt.getDateValue(), appt.getTimeValue()),
+                 appt.getStatusSymbol() != cancelled };
+}
+
+// Rounds towards minus infinity, unlike `/`
+static long long floorDiv(long long a, long long b) {
+    return a / b - ((a % b != 0 && (a < 0) != (b < 0)) ? 1 : 0);
+}
+
+void AppointmentIndex::insertKeys(int appointmentId, const Keys& keys) {
+    if (keys.start != NO_TIME) {
+        byStart.emplace(keys.start, appointmentId);
+        if (keys.blocking) refreshDay(floorDiv(keys.start, MINUTES_PER_DAY));
+    }
+}
+
+void AppointmentIndex::eraseKeys(int appointmentId, const Keys& keys) {
+    if (keys.start != NO_TIME) {
+        eraseHandle(byStart, keys.start, appointmentId);
+        if (keys.blocking) refreshDay(floorDiv(keys.start, MINUTES_PER_DAY));
+    }
+}
+
+void AppointmentIndex::link(int appointmentId, const Keys& keys) {
+    if (Pet* pet = findPetById(pets, keys.petId)) pet->linkAppointment(appointmentId);
+    if (Owner* owner = findOwnerById(owners, keys.ownerId)) owner->linkAppointment(appointmentId);
+}
+
+void AppointmentIndex::unlink(int appointmentId, const Keys& keys) {
+    if (Pet* pet = findPetById(pets, keys.petId)) pet->unlinkAppointment(appointmentId);
+    if (Owner* owner = findOwnerById(owners, keys.ownerId)) owner->unlinkAppointment(appointmentId);
+}
+
+void AppointmentIndex::refreshDay(long long day) {
+    long long opening = day * MINUTES_PER_DAY + OPENING_MINUTE;
+    uint64_t busy = 0;
+
+    // a day usually holds a handful of appointments, so rebuilding its mask is cheap
+    auto last = byStart.lower_bound(day * MINUTES_PER_DAY + CLOSING_MINUTE);
+    for (auto it = byStart.upper_bound(opening - APPOINTMENT_MINUTES); it != last; ++it) {
+        auto entry = byId.find(it->second);
+        if (entry == byId.end() || !entry->second.blocking) continue;
+
+        long long from = std::max<long long>(0, floorDiv(it->first - opening, SLOT_MINUTES));
+        long long to = std::min<long long>(SLOTS_PER_DAY,
+            floorDiv(it->first + APPOINTMENT_MINUTES - opening + SLOT_MINUTES - 1, SLOT_MINUTES));
+        for (long long slot = from; slot < to; ++slot) busy |= uint64_t{1} << slot;
+    }
+
+    if (busy) busyByDay[day] = busy;
+    else busyByDay.erase(day);
+}
+
+uint64_t AppointmentIndex::busySlots(long long day) const {
+    auto it = busyByDay.find(day);
+    return it == busyByDay.end() ? 0 : it->second;
+}
+
+template <typename Range>
+std::vector<size_t> AppointmentIndex::slotsOf(Range range) const {
+    std::vector<size_t> slots;
+    for (auto it = range.first; it != range.second; ++it) {
+        auto entry = byId.find(it->second);
+        if (entry != byId.end()) slots.push_back(entry->second.slot);
+    }
+    std::sort(slots.begin(), slots.end());
+    return slots;
+}
+
+template <typename Ptr, typename Vec>
+std::vector<Ptr> AppointmentIndex::resolve(Vec& appointments, const std::vector<int>* ids) const {
+    std::vector<Ptr> view;
+    if (!ids) return view;
+    view.reserve(ids->size());
+    for (int id : *ids) {
+        size_t slot = slotOf(id);
+        if (slot < appointments.size()) view.push_back(&appointments[slot]);
+    }
+    return view;
+}
+
+void AppointmentIndex::rebuild(const std::vector<Appointment>& appointments) {
+    byId.clear();
+    byStart.clear();
+    busyByDay.clear();
+    byStatus.clear();
+    table.rebuild(appointments);
+    byId.reserve(appointments.size());
+
+    for (auto& p : pets) p.clearAppointments();
+    for (auto& o : owners) o.clearAppointments();
+
+    for (size_t i = 0; i < appointments.size(); ++i) {
+        const Appointment& appt = appointments[i];
+        Keys keys = keysOf(appt, i);
+        auto [it, inserted] = byId.emplace(appt.getAppointmentId(), keys);
+        if (!inserted) {
+            eraseKeys(appt.getAppointmentId(), it->second);
+            it->second = keys;
+        }
+        insertKeys(appt.getAppointmentId(), keys);
+        byStatus.assign(appt.getAppointmentId(), { appt.getStatus() });
+
+        link(appt.getAppointmentId(), keys);
+    }
+}
+
+void AppointmentIndex::add(const Appointment& appt, size_t slot) {
+    Keys keys = keysOf(appt, slot);
+    auto [it, inserted] = byId.emplace(appt.getAppointmentId(), keys);
+    if (!inserted) {
+        eraseKeys(appt.getAppointmentId(), it->second);
+        unlink(appt.getAppointmentId(), it->second);
+        it->second = keys;
+    }
+    insertKeys(appt.getAppointmentId(), keys);
+    link(appt.getAppointmentId(), keys);
+    byStatus.assign(appt.getAppointmentId(), { appt.getStatus() });
+    table.set(slot, appt);
+}
+
+void AppointmentIndex::update(const Appointment& appt) {
+    auto it = byId.find(appt.getAppointmentId());
+    if (it == byId.end()) return;
+
+    byStatus.assign(appt.getAppointmentId(), { appt.getStatus() });
+    table.set(it->second.slot, appt);
+
+    Keys& keys = it->second;
+    Keys fresh = keysOf(appt, keys.slot);
+    if (keys.ownerId == fresh.ownerId && keys.petId == fresh.petId && keys.start == fresh.start
+        && keys.blocking == fresh.blocking) {
+        return;
+    }
+
+    eraseKeys(appt.getAppointmentId(), keys);
+    if (keys.ownerId != fresh.ownerId || keys.petId != fresh.petId) {
+        unlink(appt.getAppointmentId(), keys);
+        link(appt.getAppointmentId(), fresh);
+    }
+    keys = fresh;
+    insertKeys(appt.getAppointmentId(), keys);
+}
+
+void AppointmentIndex::remove(int appointmentId) {
+    auto it = byId.find(appointmentId);
+    if (it == byId.end()) return;
+
+    size_t removedSlot = it->second.slot;
+    eraseKeys(appointmentId, it->second);
+    unlink(appointmentId, it->second);
+    byStatus.remove(appointmentId);
+    table.erase(removedSlot);
+    byId.erase(it);
+
+    for (auto& entry : byId) {
+        if (entry.second.slot > removedSlot) entry.second.slot--;
+    }
+}
+
+size_t AppointmentIndex::slotOf(int appointmentId) const {
+    auto it = byId.find(appointmentId);
+    return it == byId.end() ? NOT_FOUND : it->second.slot;
+}
+
+// The pet's / owner's own list, or null if there is no such pet / owner
+static const std::vector<int>* appointmentIdsOfPet(int petId) {
+    const Pet* pet = findPetById(pets, petId);
+    return pet ? &pet->getAppointmentIds() : nullptr;
+}
+
+static const std::vector<int>* appointmentIdsOfOwner(int ownerId) {
+    const Owner* owner = findOwnerById(owners, ownerId);
+    return owner ? &owner->getAppointmentIds() : nullptr;
+}
+
+size_t AppointmentIndex::countForOwner(int ownerId) const {
+    const std::vector<int>* ids = appointmentIdsOfOwner(ownerId);
+    return ids ? ids->size() : 0;
+}
+
+size_t AppointmentIndex::countForPet(int petId) const {
+    const std::vector<int>* ids = appointmentIdsOfPet(petId);
+    return ids ? ids->size() : 0;
+}
+
+AppointmentView AppointmentIndex::forOwner(const std::vector<Appointment>& appointments, int ownerId) const {
+    return resolve<const Appointment*>(appointments, appointmentIdsOfOwner(ownerId));
+}
+
+AppointmentView AppointmentIndex::forPet(const std::vector<Appointment>& appointments, int petId) const {
+    return resolve<const Appointment*>(appointments, appointmentIdsOfPet(petId));
+}
+
+AppointmentView AppointmentIndex::onDate(const std::vector<Appointment>& appointments, const std::string& date) const {
+    long long dayStart = minuteOf(date);
+    if (dayStart == NO_TIME) return {};
+    return viewOf<const Appointment*>(appointments,
+        slotsOf(std::make_pair(byStart.lower_bound(dayStart), byStart.lower_bound(dayStart + MINUTES_PER_DAY))));
+}
+
+int AppointmentIndex::conflictWith(const std::string& date, const std::string& time, int ignoreId) const {
+    long long start = minuteOf(date, time);
+    if (start == NO_TIME) return NO_CONFLICT;
+
+    // overlapping bookings start less than APPOINTMENT_MINUTES before or after this one
+    auto last = byStart.lower_bound(start + APPOINTMENT_MINUTES);
+    for (auto it = byStart.upper_bound(start - APPOINTMENT_MINUTES); it != last; ++it) {
+        if (it->second == ignoreId) continue;
+        auto entry = byId.find(it->second);
+        if (entry != byId.end() && entry->second.blocking) return it->second;
+    }
+    return NO_CONFLICT;
+}
+
+AppointmentView AppointmentIndex::between(const std::vector<Appointment>& appointments, long long from, long long to) const {
+    AppointmentView view;
+    for (auto it = byStart.lower_bound(from); it != byStart.end() && it->first < to; ++it) {
+        size_t slot = slotOf(it->second);
+        if (slot < appointments.size()) view.push_back(&appointments[slot]);
+    }
+    return view;
+}
+
+std::vector<Appointment*> AppointmentIndex::editableForOwner(std::vector<Appointment>& appointments, int ownerId) const {
+    return resolve<Appointment*>(appointments, appointmentIdsOfOwner(ownerId));
+}
+
+std::vector<Appointment*> AppointmentIndex::editableForPet(std::vector<Appointment>& appointments, int petId) const {
+    return resolve<Appointment*>(appointments, appointmentIdsOfPet(petId));
+}
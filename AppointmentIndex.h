@@ -0,0 +1,138 @@
+#ifndef APPOINTMENTINDEX_H
+#define APPOINTMENTINDEX_H
+
+#include <vector>
+#include <string>
+#include <map>
+#include <unordered_map>
+#include <cstddef>
+#include <cstdint>
+#include "StatusIndex.h"
+#include "DateTime.h"
+#include "AppointmentColumns.h"
+
+class Appointment;
+
+// Lightweight result of an appointment query: pointers into the appointment
+// vector, in vector order. Valid until the vector is next modified.
+using AppointmentView = std::vector<const Appointment*>;
+
+// Secondary indexes over an appointment vector.
+// Appointments are referred to by ID (stable across erases and reallocation);
+// a separate ID -> slot table turns a handle back into a vector position.
+//
+// The per-pet and per-owner lists live on the Pet and Owner objects in the
+// global `pets` / `owners` (see Pet::getAppointmentIds); add, update, remove
+// and rebuild keep them in step, so rebuild after loading pets and owners.
+// The pet or owner itself is found through petIndex / ownerIndex, so "all
+// appointments for this pet" is one hash lookup plus one handle lookup per
+// appointment.
+//
+// Every appointment occupies APPOINTMENT_MINUTES from its start time. Starts
+// are kept in time order, so two bookings overlap exactly when their starts
+// are less than APPOINTMENT_MINUTES apart; a conflict check is one O(log n)
+// seek, and a calendar range is one seek plus one step per appointment shown.
+class AppointmentIndex {
+    // The indexed fields as they were when last added/updated, so a later
+    // update can find the old entries even after the appointment changed
+    struct Keys {
+        size_t slot;
+        int ownerId;
+        int petId;
+        long long start;     // minuteOf(date, time), or NO_TIME if unreadable
+        bool blocking;       // holds its time slot (i.e. not cancelled)
+    };
+
+    std::unordered_map<int, Keys> byId;
+    std::multimap<long long, int> byStart;    // start minute -> appointment ID
+    std::unordered_map<long long, uint64_t> busyByDay;   // day -> taken slots (see busySlots)
+    StatusIndex byStatus;                     // status -> appointment IDs
+    AppointmentColumns table;                 // column-wise copy, row = slot
+
+    void insertKeys(int appointmentId, const Keys& keys);
+    void eraseKeys(int appointmentId, const Keys& keys);
+    void refreshDay(long long day);   // recomputes one day's busy slots from byStart
+
+    // Adds / drops the appointment on its pet's and owner's lists
+    static void link(int appointmentId, const Keys& keys);
+    static void unlink(int appointmentId, const Keys& keys);
+
+    // Slots of the given handles, ascending (i.e. in vector order)
+    template <typename Range>
+    std::vector<size_t> slotsOf(Range range) const;
+
+    // Resolves a pet's or owner's appointment IDs against the vector
+    template <typename Ptr, typename Vec>
+    std::vector<Ptr> resolve(Vec& appointments, const std::vector<int>* ids) const;
+
+    static Keys keysOf(const Appointment& appt, size_t slot);
+
+public:
+    static constexpr size_t NOT_FOUND = static_cast<size_t>(-1);
+    static constexpr long long NO_TIME = -1;
+    static constexpr int NO_CONFLICT = 0;
+    static constexpr int APPOINTMENT_MINUTES = 30;
+    static constexpr int MINUTES_PER_DAY = 24 * 60;
+
+    // Opening hours, split into 15-minute slots for the free-slot finder
+    static constexpr int OPENING_MINUTE = 8 * 60;
+    static constexpr int CLOSING_MINUTE = 20 * 60;
+    static constexpr int SLOT_MINUTES = 15;
+    static constexpr int SLOTS_PER_DAY = (CLOSING_MINUTE - OPENING_MINUTE) / SLOT_MINUTES;
+
+    // Minutes from 1970-01-01 00:00 to the given date and time, or NO_TIME
+    // if either is invalid (or, as text, not "YYYY-MM-DD" / "HH:MM")
+    static long long minuteOf(Date date, TimeOfDay time = TimeOfDay::fromMinutes(0));
+    static long long minuteOf(const std::string& date, const std::string& time = "00:00");
+
+    // Replaces the contents with every appointment in the vector
+    void rebuild(const std::vector<Appointment>& appointments);
+
+    // Indexes an appointment just stored at the given slot
+    void add(const Appointment& appt, size_t slot);
+
+    // Re-indexes an appointment whose owner, pet, date, time or status changed
+    void update(const Appointment& appt);
+
+    // Drops an appointment that is being erased from the vector; the slots of
+    // the appointments after it move down by one
+    void remove(int appointmentId);
+
+    // Returns the slot of the appointment with this ID, or NOT_FOUND
+    size_t slotOf(int appointmentId) const;
+
+    size_t size() const { return byId.size(); }
+
+    // Appointment IDs per status ("scheduled", "completed", "cancelled").
+    // Only add/update/rebuild refresh it, so every status change (appointment,
+    // owner and pet menus alike) must be followed by update().
+    const StatusIndex& statuses() const { return byStatus; }
+
+    // The appointments column by column, row i = slot i, for status/date scans
+    const AppointmentColumns& columns() const { return table; }
+
+    size_t countForOwner(int ownerId) const;
+    size_t countForPet(int petId) const;
+
+    // The pet's / owner's appointments in ID (i.e. booking) order
+    AppointmentView forOwner(const std::vector<Appointment>& appointments, int ownerId) const;
+    AppointmentView forPet(const std::vector<Appointment>& appointments, int petId) const;
+    AppointmentView onDate(const std::vector<Appointment>& appointments, const std::string& date) const;
+
+    // ID of a booked (not cancelled) appointment overlapping one starting at
+    // date/time, other than ignoreId; NO_CONFLICT if the slot is free
+    int conflictWith(const std::string& date, const std::string& time, int ignoreId = NO_CONFLICT) const;
+
+    // Bit i is set if the slot starting at OPENING_MINUTE + i * SLOT_MINUTES on the
+    // given day (minuteOf(date) / MINUTES_PER_DAY) overlaps a booked appointment
+    uint64_t busySlots(long long day) const;
+
+    // Appointments starting in [from, to) (minutes, see minuteOf), earliest first
+    AppointmentView between(const std::vector<Appointment>& appointments, long long from, long long to) const;
+
+    // Mutable views, for callers that update the appointments they find
+    std::vector<Appointment*> editableForOwner(std::vector<Appointment>& appointments, int ownerId) const;
+    std::vector<Appointment*> editableForPet(std::vector<Appointment>& appointments, int petId) const;
+};
+
+#endif  // APPOINTMENTINDEX_H
@@ -0,0 +1,155 @@
+#include "DateTime.h"
+#include <ctime>
+#include <ostream>
+
+// Value of `count` ASCII digits at `p`; `bad` collects a non-zero bit for any
+// character that is not a digit, so the caller checks once at the end
+static int digits(const char* p, int count, unsigned& bad) {
+    int value = 0;
+    for (int i = 0; i < count; ++i) {
+        unsigned d = static_cast<unsigned char>(p[i]) - static_cast<unsigned>('0');
+        bad |= d > 9;
+        value = value * 10 + static_cast<int>(d);
+    }
+    return value;
+}
+
+// Writes `value` as `count` zero-padded digits ending just before `end`
+static void writeDigits(char* end, int count, int value) {
+    for (int i = 0; i < count; ++i) {
+        *--end = static_cast<char>('0' + value % 10);
+        value /= 10;
+    }
+}
+
+static bool isLeap(int year) {
+    return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+}
+
+static int daysInMonth(int year, int month) {
+    static const int lengths[] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+    return lengths[month - 1] + (month == 2 && isLeap(year));
+}
+
+Date Date::fromDays(int32_t days) {
+    Date date;
+    date.days = days;
+    return date;
+}
+
+Date Date::fromCivil(int year, int month, int day) {
+    if (month < 1 || month > 12 || day < 1 || day > daysInMonth(year, month)) return Date();
+
+    // days since 1970-01-01 in the proleptic Gregorian calendar (years start in March)
+    long long y = year - (month <= 2 ? 1 : 0);
+    long long era = (y >= 0 ? y : y - 399) / 400;
+    long long yearOfEra = y - era * 400;
+    long long dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    long long dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return fromDays(static_cast<int32_t>(era * 146097 + dayOfEra - 719468));
+}
+
+bool Date::parseFields(std::string_view text, int& year, int& month, int& day) {
+    if (text.size() != 10 || text[4] != '-' || text[7] != '-') return false;
+    unsigned bad = 0;
+    year = digits(text.data(), 4, bad);
+    month = digits(text.data() + 5, 2, bad);
+    day = digits(text.data() + 8, 2, bad);
+    return !bad;
+}
+
+Date Date::parse(std::string_view text) {
+    int year, month, day;
+    if (!parseFields(text, year, month, day)) return Date();
+    return fromCivil(year, month, day);
+}
+
+Date Date::today() {
+    std::time_t now = std::time(nullptr);
+    std::tm local = *std::localtime(&now);
+    return fromCivil(local.tm_year + 1900, local.tm_mon + 1, local.tm_mday);
+}
+
+void Date::civil(int& year, int& month, int& day) const {
+    long long z = static_cast<long long>(days) + 719468;
+    long long era = (z >= 0 ? z : z - 146096) / 146097;
+    long long dayOfEra = z - era * 146097;
+    long long yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    long long dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    long long shiftedMonth = (5 * dayOfYear + 2) / 153;   // March = 0
+
+    day = static_cast<int>(dayOfYear - (153 * shiftedMonth + 2) / 5 + 1);
+    month = static_cast<int>(shiftedMonth < 10 ? shiftedMonth + 3 : shiftedMonth - 9);
+    year = static_cast<int>(yearOfEra + era * 400 + (month <= 2 ? 1 : 0));
+}
+
+int Date::weekday() const {
+    // 1970-01-01 was a Thursday
+    int shifted = static_cast<int>((static_cast<long long>(days) + 4) % 7);
+    return shifted < 0 ? shifted + 7 : shifted;
+}
+
+bool Date::isWeekend() const {
+    int w = weekday();
+    return w == 0 || w == 6;
+}
+
+std::string Date::toString() const {
+    if (!valid()) return "";
+    int year, month, day;
+    civil(year, month, day);
+    char text[10] = { 0, 0, 0, 0, '-', 0, 0, '-', 0, 0 };
+    writeDigits(text + 4, 4, year);
+    writeDigits(text + 7, 2, month);
+    writeDigits(text + 10, 2, day);
+    return std::string(text, sizeof text);
+}
+
+TimeOfDay TimeOfDay::fromMinutes(int minutes) {
+    TimeOfDay time;
+    if (minutes >= 0 && minutes < 24 * 60) time.minutes = static_cast<uint16_t>(minutes);
+    return time;
+}
+
+TimeOfDay TimeOfDay::fromClock(int hour, int minute) {
+    if (hour < 0 || hour > 23 || minute < 0 || minute > 59) return TimeOfDay();
+    return fromMinutes(hour * 60 + minute);
+}
+
+bool TimeOfDay::parseFields(std::string_view text, int& hour, int& minute) {
+    if (text.size() != 5 || text[2] != ':') return false;
+    unsigned bad = 0;
+    hour = digits(text.data(), 2, bad);
+    minute = digits(text.data() + 3, 2, bad);
+    return !bad;
+}
+
+TimeOfDay TimeOfDay::parse(std::string_view text) {
+    int hour, minute;
+    if (!parseFields(text, hour, minute)) return TimeOfDay();
+    return fromClock(hour, minute);
+}
+
+std::string TimeOfDay::toString() const {
+    if (!valid()) return "";
+    char text[5] = { 0, 0, ':', 0, 0 };
+    writeDigits(text + 2, 2, hour());
+    writeDigits(text + 5, 2, minute());
+    return std::string(text, sizeof text);
+}
+
+std::ostream& operator<<(std::ostream& out, Date date) {
+    return out << date.toString();
+}
+
+std::ostream& operator<<(std::ostream& out, TimeOfDay time) {
+    return out << time.toString();
+}
+
+std::ostream& operator<<(std::ostream& out, const StoredDate& date) {
+    return out << date.toString();
+}
+
+std::ostream& operator<<(std::ostream& out, const StoredTime& time) {
+    return out << time.toString();
+}
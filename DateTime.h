@@ -0,0 +1,124 @@
+#ifndef DATETIME_H
+#define DATETIME_H
+
+#include <string>
+#include <string_view>
+#include <cstdint>
+#include <climits>
+#include <iosfwd>
+#include "Symbol.h"
+
+// Calendar day packed as the number of days since 1970-01-01 (proleptic
+// Gregorian), so dates compare, sort and subtract as plain integers.
+// "YYYY-MM-DD" text is only produced and read at the CSV / display boundary.
+// A default-constructed Date is invalid and prints as "".
+class Date {
+    int32_t days = INVALID_DAYS;
+
+public:
+    static constexpr int32_t INVALID_DAYS = INT32_MIN;
+
+    Date() = default;
+    static Date fromDays(int32_t days);
+
+    // Invalid if the day does not exist (e.g. 2025-02-29)
+    static Date fromCivil(int year, int month, int day);
+
+    // Reads "YYYY-MM-DD"; invalid if the text has another shape or names no real day
+    static Date parse(std::string_view text);
+
+    // Splits "YYYY-MM-DD" into numbers without checking the day exists;
+    // false if the text does not have that shape
+    static bool parseFields(std::string_view text, int& year, int& month, int& day);
+
+    // Today in local time
+    static Date today();
+
+    bool valid() const { return days != INVALID_DAYS; }
+    int32_t daysSinceEpoch() const { return days; }
+    void civil(int& year, int& month, int& day) const;
+    int weekday() const;                       // 0 = Sunday ... 6 = Saturday
+    bool isWeekend() const;
+    Date plusDays(int count) const { return valid() ? fromDays(days + count) : Date(); }
+
+    std::string toString() const;              // "YYYY-MM-DD", or "" if invalid
+
+    bool operator==(Date other) const { return days == other.days; }
+    bool operator!=(Date other) const { return days != other.days; }
+    bool operator<(Date other) const { return days < other.days; }
+    bool operator<=(Date other) const { return days <= other.days; }
+    bool operator>(Date other) const { return days > other.days; }
+    bool operator>=(Date other) const { return days >= other.days; }
+};
+
+// Time of day packed as minutes since midnight (0-1439).
+// A default-constructed TimeOfDay is invalid and prints as "".
+class TimeOfDay {
+    uint16_t minutes = INVALID_MINUTES;
+
+public:
+    static constexpr uint16_t INVALID_MINUTES = UINT16_MAX;
+
+    TimeOfDay() = default;
+    static TimeOfDay fromMinutes(int minutes);           // invalid outside 0-1439
+    static TimeOfDay fromClock(int hour, int minute);    // invalid outside 00:00-23:59
+
+    // Reads "HH:MM"; invalid if the text has another shape or is out of range
+    static TimeOfDay parse(std::string_view text);
+
+    // Splits "HH:MM" into numbers without range checks; false if the shape is wrong
+    static bool parseFields(std::string_view text, int& hour, int& minute);
+
+    bool valid() const { return minutes != INVALID_MINUTES; }
+    int minutesSinceMidnight() const { return minutes; }
+    int hour() const { return minutes / 60; }
+    int minute() const { return minutes % 60; }
+
+    std::string toString() const;              // "HH:MM", or "" if invalid
+
+    bool operator==(TimeOfDay other) const { return minutes == other.minutes; }
+    bool operator!=(TimeOfDay other) const { return minutes != other.minutes; }
+    bool operator<(TimeOfDay other) const { return minutes < other.minutes; }
+    bool operator<=(TimeOfDay other) const { return minutes <= other.minutes; }
+    bool operator>(TimeOfDay other) const { return minutes > other.minutes; }
+    bool operator>=(TimeOfDay other) const { return minutes >= other.minutes; }
+};
+
+// A date field of a stored record: packed when the text parses, otherwise the
+// original text (interned), so a value this program cannot read is written
+// back unchanged instead of as "".
+class StoredDate {
+    Date date;
+    Symbol text;   // only set when `date` is invalid
+
+public:
+    StoredDate() = default;
+    explicit StoredDate(Date value) : date(value) {}
+    explicit StoredDate(std::string_view value)
+        : date(Date::parse(value)), text(date.valid() ? std::string_view() : value) {}
+
+    Date value() const { return date; }            // invalid if the text did not parse
+    std::string toString() const { return date.valid() ? date.toString() : text.str(); }
+};
+
+// Same as StoredDate, for a time of day
+class StoredTime {
+    TimeOfDay time;
+    Symbol text;   // only set when `time` is invalid
+
+public:
+    StoredTime() = default;
+    explicit StoredTime(TimeOfDay value) : time(value) {}
+    explicit StoredTime(std::string_view value)
+        : time(TimeOfDay::parse(value)), text(time.valid() ? std::string_view() : value) {}
+
+    TimeOfDay value() const { return time; }       // invalid if the text did not parse
+    std::string toString() const { return time.valid() ? time.toString() : text.str(); }
+};
+
+std::ostream& operator<<(std::ostream& out, Date date);
+std::ostream& operator<<(std::ostream& out, TimeOfDay time);
+std::ostream& operator<<(std::ostream& out, const StoredDate& date);
+std::ostream& operator<<(std::ostream& out, const StoredTime& time);
+
+#endif  // DATETIME_H
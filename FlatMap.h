@@ -0,0 +1,111 @@
+#ifndef FLATMAP_H
+#define FLATMAP_H
+
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+
+// Sorted map kept in one contiguous vector of (key, value) pairs.
+// Lookups are a binary search and iteration is a straight walk through memory,
+// unlike std::map's one heap node per entry. Inserting in the middle shifts the
+// entries after it, so it suits maps whose keys mostly arrive in ascending
+// order (record IDs handed out by a counter): a key past the current last one
+// is appended without a search.
+//
+// Offers the subset of std::map used here. Iterators and references are
+// invalidated by any insert or erase, as for std::vector.
+template <typename Key, typename Value>
+class FlatMap {
+public:
+    using value_type = std::pair<Key, Value>;
+    using iterator = typename std::vector<value_type>::iterator;
+    using const_iterator = typename std::vector<value_type>::const_iterator;
+
+private:
+    std::vector<value_type> items;   // ascending by key, keys unique
+
+    // Position of the first entry not below the key
+    size_t lowerIndex(const Key& key) const {
+        if (items.empty() || items.back().first < key) return items.size();
+        // halving search without a data-dependent branch, so it does not stall
+        // on mispredictions; the compiler turns the step into a conditional move
+        const value_type* base = items.data();
+        size_t length = items.size();
+        while (length > 1) {
+            size_t half = length / 2;
+            base = base[half - 1].first < key ? base + half : base;
+            length -= half;
+        }
+        return static_cast<size_t>(base - items.data()) + (base->first < key);
+    }
+
+    iterator lowerBound(const Key& key) { return items.begin() + lowerIndex(key); }
+    const_iterator lowerBound(const Key& key) const { return items.begin() + lowerIndex(key); }
+
+public:
+    iterator begin() { return items.begin(); }
+    iterator end() { return items.end(); }
+    const_iterator begin() const { return items.begin(); }
+    const_iterator end() const { return items.end(); }
+
+    bool empty() const { return items.empty(); }
+    size_t size() const { return items.size(); }
+    void clear() { items.clear(); }
+    void reserve(size_t count) { items.reserve(count); }
+
+    iterator find(const Key& key) {
+        iterator it = lowerBound(key);
+        return it != items.end() && it->first == key ? it : items.end();
+    }
+
+    const_iterator find(const Key& key) const {
+        const_iterator it = lowerBound(key);
+        return it != items.end() && it->first == key ? it : items.end();
+    }
+
+    size_t count(const Key& key) const { return find(key) != items.end() ? 1 : 0; }
+
+    // Value for the key; throws std::out_of_range if it is missing, like std::map::at
+    Value& at(const Key& key) {
+        iterator it = find(key);
+        if (it == items.end()) throw std::out_of_range("FlatMap::at: key not found");
+        return it->second;
+    }
+
+    const Value& at(const Key& key) const {
+        const_iterator it = find(key);
+        if (it == items.end()) throw std::out_of_range("FlatMap::at: key not found");
+        return it->second;
+    }
+
+    // Value for the key, inserting a default one if it is missing
+    Value& operator[](const Key& key) {
+        iterator it = lowerBound(key);
+        if (it == items.end() || it->first != key) it = items.insert(it, value_type(key, Value()));
+        return it->second;
+    }
+
+    // Inserts or replaces the value for the key
+    iterator insert_or_assign(const Key& key, Value value) {
+        iterator it = lowerBound(key);
+        if (it != items.end() && it->first == key) {
+            it->second = std::move(value);
+            return it;
+        }
+        return items.insert(it, value_type(key, std::move(value)));
+    }
+
+    // Number of entries removed (0 or 1)
+    size_t erase(const Key& key) {
+        iterator it = find(key);
+        if (it == items.end()) return 0;
+        items.erase(it);
+        return 1;
+    }
+
+    iterator erase(const_iterator position) { return items.erase(position); }
+};
+
+#endif  // FLATMAP_H
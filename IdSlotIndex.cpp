@@ -0,0 +1,58 @@
+#include "IdSlotIndex.h"
+#include <climits>
+
+// Marks an unused table entry; real IDs are positive
+static const int EMPTY_ID = INT_MIN;
+
+size_t IdSlotIndex::bucketOf(int id) const {
+    // Fibonacci hashing spreads sequential IDs across the table
+    uint64_t h = static_cast<uint64_t>(static_cast<uint32_t>(id)) * 0x9E3779B97F4A7C15ull;
+    return static_cast<size_t>(h >> shift);
+}
+
+void IdSlotIndex::grow() {
+    std::vector<Entry> old = std::move(table);
+    size_t capacity = old.empty() ? 16 : old.size() * 2;
+
+    table.assign(capacity, Entry{ EMPTY_ID, 0 });
+    shift = 64;
+    for (size_t c = capacity; c > 1; c >>= 1) shift--;
+    count = 0;
+
+    for (const Entry& e : old) {
+        if (e.id != EMPTY_ID) insert(e.id, e.slot);
+    }
+}
+
+void IdSlotIndex::insert(int id, size_t slot) {
+    if ((count + 1) * 2 > table.size()) grow();
+
+    size_t mask = table.size() - 1;
+    for (size_t i = bucketOf(id); ; i = (i + 1) & mask) {
+        if (table[i].id == id) {
+            table[i].slot = static_cast<uint32_t>(slot);
+            return;
+        }
+        if (table[i].id == EMPTY_ID) {
+            table[i] = Entry{ id, static_cast<uint32_t>(slot) };
+            count++;
+            return;
+        }
+    }
+}
+
+size_t IdSlotIndex::find(int id) const {
+    if (table.empty()) return NOT_FOUND;
+
+    size_t mask = table.size() - 1;
+    for (size_t i = bucketOf(id); ; i = (i + 1) & mask) {
+        if (table[i].id == id) return table[i].slot;
+        if (table[i].id == EMPTY_ID) return NOT_FOUND;
+    }
+}
+
+void IdSlotIndex::clear() {
+    table.clear();
+    count = 0;
+    shift = 64;
+}
@@ -0,0 +1,39 @@
+#ifndef IDSLOTINDEX_H
+#define IDSLOTINDEX_H
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+// Hash index from an entity ID to the entity's position (slot) in its vector.
+// Open addressing with linear probing over a power-of-two table kept at most
+// half full, so a lookup touches one or two adjacent entries on average.
+// Slots stay valid when the vector reallocates; erasing from the vector shifts
+// slots, so the index is rebuilt after an erase.
+class IdSlotIndex {
+    struct Entry {
+        int id;
+        uint32_t slot;
+    };
+
+    std::vector<Entry> table;
+    size_t count = 0;
+    unsigned shift = 64;              // 64 - log2(table size), for Fibonacci hashing
+
+    size_t bucketOf(int id) const;
+    void grow();
+
+public:
+    static constexpr size_t NOT_FOUND = static_cast<size_t>(-1);
+
+    // Records that the entity with this ID is at the given slot (inserts or overwrites)
+    void insert(int id, size_t slot);
+
+    // Returns the slot of the entity with this ID, or NOT_FOUND
+    size_t find(int id) const;
+
+    size_t size() const { return count; }
+    void clear();
+};
+
+#endif  // IDSLOTINDEX_H
@@ -0,0 +1,62 @@
+#include "NameIndex.h"
+#include "Pet.h"
+#include "Owner.h"
+#include "validations.h"
+#include <algorithm>
+#include <cctype>
+#include <climits>
+
+void NameIndex::rebuild(const std::vector<Pet>& pets) {
+    keys.clear();
+    keysOf.clear();
+    keysOf.reserve(pets.size());
+    for (const auto& p : pets) assign(p.getPetId(), { p.getName(), p.getBreed() });
+}
+
+void NameIndex::rebuild(const std::vector<Owner>& owners) {
+    keys.clear();
+    keysOf.clear();
+    keysOf.reserve(owners.size());
+    for (const auto& o : owners) assign(o.getOwnerId(), { o.getName() });
+}
+
+void NameIndex::assign(int id, const std::vector<std::string>& names) {
+    remove(id);
+
+    std::vector<std::string>& entries = keysOf[id];
+    for (const auto& name : names) {
+        std::string normalized = normalizeKey(name);
+        for (size_t i = 0; i < normalized.size(); ++i) {
+            // one entry per word: the text from the start of the word onwards
+            bool wordStart = std::isalnum(static_cast<unsigned char>(normalized[i]))
+                          && (i == 0 || !std::isalnum(static_cast<unsigned char>(normalized[i - 1])));
+            if (wordStart) entries.push_back(normalized.substr(i));
+        }
+    }
+
+    // the same word may appear in both name and breed
+    std::sort(entries.begin(), entries.end());
+    entries.erase(std::unique(entries.begin(), entries.end()), entries.end());
+    for (const auto& key : entries) keys.emplace(key, id);
+}
+
+void NameIndex::remove(int id) {
+    auto it = keysOf.find(id);
+    if (it == keysOf.end()) return;
+    for (const auto& key : it->second) keys.erase({ key, id });
+    keysOf.erase(it);
+}
+
+std::vector<int> NameIndex::findPrefix(std::string_view prefix, size_t limit) const {
+    std::vector<int> ids;
+    std::string wanted = normalizeKey(prefix);
+    if (wanted.empty()) return ids;
+
+    for (auto it = keys.lower_bound({ wanted, INT_MIN });
+         it != keys.end() && ids.size() < limit && it->first.compare(0, wanted.size(), wanted) == 0;
+         ++it) {
+        // an ID can match through several words; keep its first (alphabetical) match
+        if (std::find(ids.begin(), ids.end(), it->second) == ids.end()) ids.push_back(it->second);
+    }
+    return ids;
+}
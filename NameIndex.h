@@ -0,0 +1,43 @@
+#ifndef NAMEINDEX_H
+#define NAMEINDEX_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include <cstddef>
+
+class Pet;
+class Owner;
+
+// Sorted prefix index for "search by name" lookups.
+// Every word of an indexed name (pet name and breed, or owner name) is stored
+// normalized (trimmed, lower-case) together with the rest of the name after it,
+// so "car" finds "Emily Carter" and "emily c" finds her too. Matches for a
+// prefix are adjacent in the set, so a lookup costs one O(log n) seek plus one
+// step per match returned.
+class NameIndex {
+    std::set<std::pair<std::string, int>> keys;             // (name suffix, ID)
+    std::unordered_map<int, std::vector<std::string>> keysOf; // ID -> its entries in `keys`
+
+public:
+    // Replaces the contents with every pet's name and breed / every owner's name
+    void rebuild(const std::vector<Pet>& pets);
+    void rebuild(const std::vector<Owner>& owners);
+
+    // Sets the names an ID is found by, replacing any it had
+    void assign(int id, const std::vector<std::string>& names);
+
+    // Forgets an ID; call when the pet or owner is deleted
+    void remove(int id);
+
+    // IDs with a name word starting with the prefix, at most `limit`,
+    // in alphabetical order of the matching word
+    std::vector<int> findPrefix(std::string_view prefix, size_t limit = 20) const;
+
+    size_t size() const { return keysOf.size(); }
+};
+
+#endif  // NAMEINDEX_H
@@ -4,6 +4,10 @@
 #include <fstream>
 #include <string>
 #include <sstream>
+#include <algorithm>
+#include "parallel_load.h"
+#include "validations.h"
+#include "globals.h"
 
 
 
@@ -22,12 +26,17 @@ std::string Owner::getEmail() const {return email;}
     // add owner record, auto assign id
 void Owner::addRecord(const std::string& date, const std::string& details) { // just reading, no modification
     records[nextRecordId] = Record(date, details, "Owner"); // id:data; dict
+    textIndex.indexRecord(RecordSource::OwnerRecord, ownerId, nextRecordId, details);
     std::cout << "Record added with ID: " << nextRecordId << "\n";
     nextRecordId ++;
 }
 
-void Owner::addRecordWithId(int id, const std::string& date, const std::string& details) {
-    records[id] = Record(date, details, "Owner");
+void Owner::addRecordWithId(int id, StoredDate date, std::string_view details) {
+    addRecordWithId(id, date, details, loadedText);
+}
+
+void Owner::addRecordWithId(int id, StoredDate date, std::string_view details, TextArena& text) {
+    records.insert_or_assign(id, Record(date, ArenaString::inArena(text.store(details)), "Owner"));
     if (id >= nextRecordId) nextRecordId = id + 1;
 }
 
@@ -36,12 +45,13 @@ void Owner::updateRecord(int recordId, const std::string& newDate, const std::st
     if (it != records.end()) {
         it->second.updateDate(newDate);
         it->second.updateDetails(newDetails);
+        textIndex.indexRecord(RecordSource::OwnerRecord, ownerId, recordId, newDetails);
     } else {
         std::cerr << "❌ Record ID not found!\n";
     }
 }
 
-const std::map<int, Record>& Owner::getRecords() const {
+const RecordMap& Owner::getRecords() const {
     return records;
 }
 
@@ -55,6 +65,7 @@ bool Owner::hasRecord(int recordId) const {
 
 void Owner::removeRecord(int recordId) {
     if (records.erase(recordId)) {
+        textIndex.removeRecord(RecordSource::OwnerRecord, ownerId, recordId);
         std::cout << "✅ Record " << recordId << " removed successfully.\n";
     } else {
         std::cerr << "❌ Record ID not found!\n";
@@ -92,17 +103,32 @@ void Owner::setEmail(const std::string& newEmail) {
 
 
 
-    // add an appointement
-void Owner::addAppointment(const Appointment* appt) {
-    appointments.push_back(appt);
+// Linked appointments, kept sorted so lookups and removal are a binary search
+void Owner::linkAppointment(int appointmentId) {
+    auto it = std::lower_bound(appointmentIds.begin(), appointmentIds.end(), appointmentId);
+    if (it == appointmentIds.end() || *it != appointmentId) appointmentIds.insert(it, appointmentId);
+}
+
+void Owner::unlinkAppointment(int appointmentId) {
+    auto it = std::lower_bound(appointmentIds.begin(), appointmentIds.end(), appointmentId);
+    if (it != appointmentIds.end() && *it == appointmentId) appointmentIds.erase(it);
+}
+
+void Owner::clearAppointments() {
+    appointmentIds.clear();
+}
+
+const std::vector<int>& Owner::getAppointmentIds() const {
+    return appointmentIds;
 }
 
 void Owner::displayAppointments() const {
-    if (appointments.empty()) {
+    if (appointmentIds.empty()) {
         std::cout << "❌ No appointments for " << name << ".\n";
+        return;
     }
     std::cout << "Appointments for " << name << ":\n";
-    for (const auto& appt : appointments) {
+    for (const Appointment* appt : appointmentIndex.forOwner(appointments, ownerId)) {
         appt->displayAppointmentDetails();
     }
 }
@@ -133,98 +159,105 @@ std::vector<int> Owner::getPetIds() const {
 std::vector<int>& Owner::getPetIdsRef() { return petIds; }
 
 
-std::vector<Owner> Owner::loadFromFile(const std::string& filename) {
-    std::vector<Owner> owners; // to store owners
-
-    std::ifstream file(filename); // open file to read from
-    if (!file) {
-        std::cerr << "Erro. No such file!\n";
-        return owners; // return empty list if nothing
+std::vector<Owner> Owner::loadFromFile(const std::string& filename, int& nextOwnerId) {
+    MappedFile file(filename); // open file to read from
+    if (!file.isOpen()) {
+        writeLoadLog("Erro. No such file!\n");
+        return {}; // return empty list if nothing
     }
 
-    std::string line;
-    std::getline(file, line); // skip header, do not process
+    std::string_view text = file.view();
+    size_t pos = 0;
+    nextLine(text, pos); // skip header, do not process
 
-    // std::cout << "\nFile Content:\n";
-    while (std::getline(file, line)) { // loop over every line, each line is one owner
-        if(line.empty()) continue; // skip empty lines
+    // each line is one owner
+    return parseCsvBody<Owner>(text.substr(pos),
+        [](std::string_view line, std::vector<Owner>& owners, std::ostream& log, TextArena& text) {
+            return parseCsvLine(std::string(line), owners, log, text);
+        },
+        [](const Owner& o) { return o.ownerId; }, nextOwnerId, loadedText);
+}
 
-        std::stringstream ss(line);
-        std::string idStr, name, address, phone, email, petIdsData, recordData;
+bool Owner::parseCsvLine(const std::string& line, std::vector<Owner>& owners, std::ostream& log) {
+    return parseCsvLine(line, owners, log, loadedText);
+}
 
-        std::getline(ss, idStr, ',');
-        std::getline(ss, name, ',');
-        std::getline(ss, address, ',');
-        address = unescapeCommas(address);
-        std::getline(ss, phone, ',');
-        std::getline(ss, email, ',');
-        std::getline(ss, petIdsData, ',');
-        std::getline(ss, recordData); // full record string
+bool Owner::parseCsvLine(const std::string& line, std::vector<Owner>& owners, std::ostream& log, TextArena& text) {
+    if(line.empty()) return false; // skip empty lines
 
-        if (idStr.empty()) {
-            std::cerr << "skipping malformed owner record: " << line << "\n";
-            continue;
-        }
-        
-
-        // int ownerId = std::stoi(idStr);
-        int ownerId;
-        try {
-            ownerId = std::stoi(idStr);
-        } catch (const std::exception& e) {
-            std::cerr << "Invalid owner ID in line: " << line << "\n";
-            continue;
-        }
+    std::stringstream ss(line);
+    std::string idStr, name, address, phone, email, petIdsData, recordData;
+
+    std::getline(ss, idStr, ',');
+    std::getline(ss, name, ',');
+    std::getline(ss, address, ',');
+    address = unescapeCommas(address);
+    std::getline(ss, phone, ',');
+    std::getline(ss, email, ',');
+    std::getline(ss, petIdsData, ',');
+    std::getline(ss, recordData); // full record string
+
+    if (idStr.empty()) {
+        log << "skipping malformed owner record: " << line << "\n";
+        return false;
+    }
+    
 
-        Owner owner(ownerId, name, address, phone, email);
+    // int ownerId = std::stoi(idStr);
+    int ownerId;
+    try {
+        ownerId = std::stoi(idStr);
+    } catch (const std::exception& e) {
+        log << "Invalid owner ID in line: " << line << "\n";
+        return false;
+    }
+
+    Owner owner(ownerId, name, address, phone, email);
 
-        // pet ids
-        std::stringstream petIdStream(petIdsData);
-        std::string petIdStr;
+    // pet ids
+    std::stringstream petIdStream(petIdsData);
+    std::string petIdStr;
 
 
-        while (std::getline(petIdStream, petIdStr, ';')) {
-            if (!petIdStr.empty()) {
-                try {
-                    owner.addPetId(std::stoi(petIdStr));
-                } catch (...) {
-                    std::cerr << "INvalid pet ID for owner " << ownerId << "\n";
-                }
+    while (std::getline(petIdStream, petIdStr, ';')) {
+        if (!petIdStr.empty()) {
+            try {
+                owner.addPetId(std::stoi(petIdStr));
+            } catch (...) {
+                log << "INvalid pet ID for owner " << ownerId << "\n";
             }
         }
+    }
 
-        // split records by ";"
-        std::stringstream recordStream(recordData);
-        std::string record;
-        while (std::getline(recordStream, record, ';')) { // ??????????????
-            std::stringstream recordParts(record);
-            std::string recIdStr, date, details;
-            std::getline(recordParts, recIdStr, '|');
-            std::getline(recordParts, date, '|');
-            std::getline(recordParts, details, '|');
-            details = unescapeCommas(details);
-
-            if (!recIdStr.empty()) { // avoid empty records
-                try {
-                    int recordId = std::stoi(recIdStr);
-                    owner.addRecordWithId(recordId, date, details);
-
-                } catch (...) {
-                    std::cerr << "Invalid record id for owner " << ownerId << "\n";
-                }
-                
+    // split records by ";"
+    std::stringstream recordStream(recordData);
+    std::string record;
+    while (std::getline(recordStream, record, ';')) { // ??????????????
+        std::stringstream recordParts(record);
+        std::string recIdStr, date, details;
+        std::getline(recordParts, recIdStr, '|');
+        std::getline(recordParts, date, '|');
+        std::getline(recordParts, details, '|');
+        details = unescapeCommas(details);
+
+        if (!recIdStr.empty()) { // avoid empty records
+            try {
+                int recordId = std::stoi(recIdStr);
+                owner.addRecordWithId(recordId, StoredDate(date), details, text);
+
+            } catch (...) {
+                log << "Invalid record id for owner " << ownerId << "\n";
             }
+            
         }
-
-        owners.push_back(owner); // add owner to the list
     }
-    
-    file.close();
-    return owners;
+
+    owners.push_back(owner); // add owner to the list
+    return true;
 }
 
 
-void Owner::writeToFileStream(std::ofstream& file) const {
+void Owner::writeToFileStream(std::ostream& file) const {
     if (!file) {
         std::cerr << "File stream is not open!\n";
         return;
@@ -295,6 +328,7 @@ void Owner::deleteRecord(int recordId) {
     auto it = records.find(recordId);
     if (it != records.end()) {
         records.erase(it);
+        textIndex.removeRecord(RecordSource::OwnerRecord, ownerId, recordId);
     } else {
         std::cerr << "Record ID not found for this owner.\n";
     }
@@ -316,11 +350,8 @@ void Owner::displayLinkedPets(const std::vector<Pet>& pets) const {
     // Collect found pets
     std::vector<const Pet*> linkedPets;
     for (int petId : petIds) {
-        auto it = std::find_if(pets.begin(), pets.end(), [petId](const Pet& p) {
-            return p.getPetId() == petId;
-        });
-        if (it != pets.end()) {
-            linkedPets.push_back(&(*it));
+        if (const Pet* pet = findPetById(pets, petId)) {
+            linkedPets.push_back(pet);
         }
     }
 
@@ -19,8 +19,8 @@ private:
     int ownerId;                          // Unique ID for the owner
     std::string name, address, phone_number, email;
 
-    std::map<int, Record> records;        // Medical/general records linked to the owner
-    std::vector<const Appointment*> appointments; // Appointments linked to this owner
+    RecordMap records;                    // Medical/general records linked to the owner
+    std::vector<int> appointmentIds;      // Linked appointment IDs, ascending; kept by AppointmentIndex
     int nextRecordId = 1;                 // ID counter for records
     std::vector<int> petIds;              // IDs of pets owned by this owner
 
@@ -37,7 +37,7 @@ public:
     std::vector<int> getPetIds() const;
     std::vector<int>& getPetIdsRef();
     int getRecordCount() const;                           // Returns total number of records
-    const std::map<int, Record>& getRecords() const;      // Returns reference to owner's records
+    const RecordMap& getRecords() const;                  // Returns reference to owner's records
 
     void removePetId(int petId);
 
@@ -49,7 +49,8 @@ public:
 
     // Record handling
     void addRecord(const std::string& date, const std::string& details);                  // Adds a new record with auto ID
-    void addRecordWithId(int id, const std::string& date, const std::string& details);    // Loads a record with existing ID
+    void addRecordWithId(int id, StoredDate date, std::string_view details);                // Loads a record with existing ID
+    void addRecordWithId(int id, StoredDate date, std::string_view details, TextArena& text); // Same, details stored in `text`
     void updateRecord(int recordId, const std::string& newDate, const std::string& newDetails); // Updates a record
     void removeRecord(int recordId);                      // Removes a record
     void displayRecords() const;                          // Displays all records in a table
@@ -58,12 +59,20 @@ public:
     void deleteRecord(int recordId);                      // Deletes a specific record
 
     // Appointment handling
-    void addAppointment(const Appointment* appt);         // Adds a linked appointment to the owner
+    void linkAppointment(int appointmentId);              // Adds an appointment ID (called by AppointmentIndex)
+    void unlinkAppointment(int appointmentId);            // Drops an appointment ID (called by AppointmentIndex)
+    void clearAppointments();                             // Forgets every linked appointment
+    const std::vector<int>& getAppointmentIds() const;    // Linked appointment IDs, ascending
     void displayAppointments() const;                     // Displays all appointments for this owner
 
     // File I/O
-    static std::vector<Owner> loadFromFile(const std::string& filename); // Loads owners from a file
-    void writeToFileStream(std::ofstream& file) const;    // Writes the owner's data to a file stream
+    // Loads owners from a file, raising nextOwnerId past every loaded ID
+    static std::vector<Owner> loadFromFile(const std::string& filename, int& nextOwnerId);
+    // Parses one CSV row and appends it; problems are reported to log
+    static bool parseCsvLine(const std::string& line, std::vector<Owner>& owners, std::ostream& log = std::cerr);
+    // Same, storing the record details in `text` instead of loadedText
+    static bool parseCsvLine(const std::string& line, std::vector<Owner>& owners, std::ostream& log, TextArena& text);
+    void writeToFileStream(std::ostream& file) const;     // Writes the owner's data to a file stream
 
     // Pet and display-related methods
     void addPetId(int PetId);                             // Links a pet ID to this owner
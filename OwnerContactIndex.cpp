@@ -0,0 +1,103 @@
+#include "OwnerContactIndex.h"
+#include "Owner.h"
+#include "mapped_file.h"
+#include "validations.h"
+#include <iostream>
+#include <sstream>
+
+void OwnerContactIndex::rebuild(const std::vector<Owner>& owners) {
+    ownerByPhone.clear();
+    ownerByEmail.clear();
+    ownerByPhone.reserve(owners.size());
+    ownerByEmail.reserve(owners.size());
+    for (const auto& o : owners) add(o);
+}
+
+void OwnerContactIndex::add(const Owner& owner) {
+    // a missing phone / email is not a contact anyone can clash with
+    std::string phone = normalizeKey(owner.getPhoneNumber());
+    std::string email = normalizeKey(owner.getEmail());
+    if (!phone.empty()) ownerByPhone.emplace(std::move(phone), owner.getOwnerId());
+    if (!email.empty()) ownerByEmail.emplace(std::move(email), owner.getOwnerId());
+}
+
+void OwnerContactIndex::remove(const Owner& owner) {
+    // only drop keys this owner actually holds
+    auto phone = ownerByPhone.find(normalizeKey(owner.getPhoneNumber()));
+    if (phone != ownerByPhone.end() && phone->second == owner.getOwnerId()) ownerByPhone.erase(phone);
+
+    auto email = ownerByEmail.find(normalizeKey(owner.getEmail()));
+    if (email != ownerByEmail.end() && email->second == owner.getOwnerId()) ownerByEmail.erase(email);
+}
+
+int OwnerContactIndex::ownerWithPhone(std::string_view phone) const {
+    auto it = ownerByPhone.find(normalizeKey(phone));
+    return it == ownerByPhone.end() ? NO_OWNER : it->second;
+}
+
+int OwnerContactIndex::ownerWithEmail(std::string_view email) const {
+    auto it = ownerByEmail.find(normalizeKey(email));
+    return it == ownerByEmail.end() ? NO_OWNER : it->second;
+}
+
+
+// Reports one field of one row if it clashes with a loaded owner or an earlier row;
+// otherwise remembers it. Empty fields are skipped. Returns true if it was a duplicate.
+static bool checkContact(const std::string& label, const std::string& value, size_t lineNo, int existingOwner,
+                         std::unordered_map<std::string, size_t>& seenInFile) {
+    std::string key = normalizeKey(value);
+    if (key.empty()) return false;
+
+    if (existingOwner != OwnerContactIndex::NO_OWNER) {
+        std::cout << "⚠️ Line " << lineNo << ": " << label << " " << value
+                  << " is already used by owner 🆔 " << existingOwner << "\n";
+        return true;
+    }
+
+    auto [it, inserted] = seenInFile.emplace(std::move(key), lineNo);
+    if (!inserted) {
+        std::cout << "⚠️ Line " << lineNo << ": " << label << " " << value
+                  << " repeats line " << it->second << "\n";
+        return true;
+    }
+    return false;
+}
+
+int validateOwnerFile(const std::string& filename, const OwnerContactIndex& existing) {
+    MappedFile file(filename);
+    if (!file.isOpen()) {
+        std::cerr << "Error opening " << filename << "\n";
+        return OWNER_FILE_UNREADABLE;
+    }
+
+    std::string_view text = file.view();
+    size_t pos = 0;
+    nextLine(text, pos); // header
+
+    std::unordered_map<std::string, size_t> phonesSeen, emailsSeen;
+    std::vector<Owner> row;
+    std::ostringstream parseErrors;
+    TextArena rowText;   // record details of the checked rows, dropped with them
+    size_t lineNo = 1, checked = 0, duplicates = 0, malformed = 0;
+
+    while (pos < text.size()) {
+        std::string_view line = nextLine(text, pos);
+        lineNo++;
+
+        row.clear();
+        if (!Owner::parseCsvLine(std::string(line), row, parseErrors, rowText) || row.empty()) {
+            malformed++;
+            continue;
+        }
+        const Owner& o = row.front();
+        checked++;
+
+        if (checkContact("phone", o.getPhoneNumber(), lineNo, existing.ownerWithPhone(o.getPhoneNumber()), phonesSeen)) duplicates++;
+        if (checkContact("email", o.getEmail(), lineNo, existing.ownerWithEmail(o.getEmail()), emailsSeen)) duplicates++;
+    }
+
+    std::cerr << parseErrors.str();
+    std::cout << "📋 Checked " << checked << " owner(s) in " << filename << ": "
+              << duplicates << " duplicate contact(s), " << malformed << " malformed line(s) found.\n";
+    return duplicates == 0 && malformed == 0 ? OWNER_FILE_OK : OWNER_FILE_PROBLEMS;
+}
@@ -0,0 +1,49 @@
+#ifndef OWNERCONTACTINDEX_H
+#define OWNERCONTACTINDEX_H
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+class Owner;
+
+// Uniqueness index for owner phone numbers and emails.
+// Keys are normalized (trimmed, lower-case) so "A@x.com " and "a@x.com" clash,
+// and map to the ID of the owner holding them.
+class OwnerContactIndex {
+    std::unordered_map<std::string, int> ownerByPhone;
+    std::unordered_map<std::string, int> ownerByEmail;
+
+public:
+    static constexpr int NO_OWNER = -1;
+
+    // Replaces the contents with the contacts of every owner in the vector
+    void rebuild(const std::vector<Owner>& owners);
+
+    // Registers an owner's phone and email (an already-taken key keeps its first
+    // owner; empty fields are not registered)
+    void add(const Owner& owner);
+
+    // Unregisters an owner's phone and email; call before changing or deleting them
+    void remove(const Owner& owner);
+
+    // ID of the owner using this phone number / email, or NO_OWNER
+    int ownerWithPhone(std::string_view phone) const;
+    int ownerWithEmail(std::string_view email) const;
+};
+
+// Results of validateOwnerFile, used as the process exit status
+enum OwnerFileCheck {
+    OWNER_FILE_OK = 0,           // every row parsed, no duplicates
+    OWNER_FILE_PROBLEMS = 1,     // duplicates or malformed rows were reported
+    OWNER_FILE_UNREADABLE = 2    // the file could not be opened
+};
+
+// Checks an owners CSV file (same layout as owners.csv) for phone numbers and
+// emails that repeat within the file or clash with the loaded owners, in one pass.
+// Empty phone / email fields are not compared. Every duplicate is reported to
+// std::cout and every malformed row to std::cerr.
+int validateOwnerFile(const std::string& filename, const OwnerContactIndex& existing);
+
+#endif  // OWNERCONTACTINDEX_H
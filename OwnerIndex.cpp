@@ -0,0 +1,9 @@
+#include "OwnerIndex.h"
+#include "Owner.h"
+
+void OwnerIndex::rebuild(const std::vector<Owner>& owners) {
+    clear();
+    for (size_t i = 0; i < owners.size(); ++i) {
+        insert(owners[i].getOwnerId(), i);
+    }
+}
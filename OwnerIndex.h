@@ -0,0 +1,16 @@
+#ifndef OWNERINDEX_H
+#define OWNERINDEX_H
+
+#include <vector>
+#include "IdSlotIndex.h"
+
+class Owner;
+
+// Owner ID -> position in an owner vector (see IdSlotIndex)
+class OwnerIndex : public IdSlotIndex {
+public:
+    // Replaces the contents with the IDs of all owners in the vector
+    void rebuild(const std::vector<Owner>& owners);
+};
+
+#endif  // OWNERINDEX_H
@@ -2,53 +2,74 @@
 #include "Owner.h"
 #include "globals.h"
 #include <fstream>
+#include <charconv>
+#include <cctype>
+#include <algorithm>
 #include "Vaccination.h"
 #include "validations.h"
+#include "parallel_load.h"
 
 
 
 // constructor
 Pet::Pet(int petId, const std::string& name, const std::string& breed, const int age, int ownerId) 
-    : petId(petId), name(name), breed(breed), age(age), ownerId(ownerId) {}
+    : petId(petId), name(name), breed(Symbol(breed)), age(age), ownerId(ownerId) {}
 
 // getters
 std::string Pet::getName() const {return name;}
-std::string Pet::getBreed() const {return breed;}
+const std::string& Pet::getBreed() const {return breed.str();}
 int Pet::getAge() const {return age;}
 int Pet::getPetId() const {return petId;}
 int Pet::getOnwerId() const {return ownerId;}
-const std::map<int, Record>& Pet::getPetRecords() const { return petRecords; }
-const std::map<int, Record>& Pet::getMedicalHistory() const { return medicalHistory; }
+const RecordMap& Pet::getPetRecords() const { loadPetRecords(); return petRecords; }
+const RecordMap& Pet::getMedicalHistory() const { loadMedicalHistory(); return medicalHistory; }
+const std::vector<Vaccination>& Pet::getVaccinations() const { return vaccinations; }
 
 
 bool Pet::hasMedicalHistory() const {
+    loadMedicalHistory();
     return !medicalHistory.empty();
 }
 
-bool Pet::hasRecords(const std::map<int, Record>& recordMap) const {
+bool Pet::hasRecords(const RecordMap& recordMap) const {
     return !recordMap.empty();
 }
 
-bool Pet::hasRecord(int recordId, const std::map<int, Record>& recordMap) const {
+bool Pet::hasRecord(int recordId, const RecordMap& recordMap) const {
     return recordMap.find(recordId) != recordMap.end();
 }
 
-void Pet::setName(const std::string& newName) { name = newName; }
-void Pet::setBreed(const std::string& newBreed) { breed = newBreed; }
-void Pet::setAge(int newAge) { age = newAge; }
+void Pet::setName(const std::string& newName) { name = newName; rowDirty = true; }
+void Pet::setBreed(const std::string& newBreed) { breed = Symbol(newBreed); rowDirty = true; }
+void Pet::setAge(int newAge) { age = newAge; rowDirty = true; }
 
 
 void Pet::setOwnerId(int newOwnerId) {
+    rowDirty = true;
     ownerId = newOwnerId;
 }
 
+// Appointment IDs stay sorted so linking and unlinking are a binary search
+void Pet::linkAppointment(int appointmentId) {
+    auto it = std::lower_bound(appointmentIds.begin(), appointmentIds.end(), appointmentId);
+    if (it == appointmentIds.end() || *it != appointmentId) appointmentIds.insert(it, appointmentId);
+}
+
+void Pet::unlinkAppointment(int appointmentId) {
+    auto it = std::lower_bound(appointmentIds.begin(), appointmentIds.end(), appointmentId);
+    if (it != appointmentIds.end() && *it == appointmentId) appointmentIds.erase(it);
+}
+
+void Pet::clearAppointments() { appointmentIds.clear(); }
+
+const std::vector<int>& Pet::getAppointmentIds() const { return appointmentIds; }
+
 
 std::string Pet::calculateVaccinationStatus() const {
     if (vaccinations.empty()) return "none";
 
     for (const auto& v : vaccinations) {
-        if (v.getStatus() == "pending" || v.getStatus() == "booster required")
-            return "pending";
+        if (v.isOutstanding()) return "pending";
     }
     return "completed";
 }
@@ -56,7 +77,7 @@ std::string Pet::calculateVaccinationStatus() const {
 
 
 
-void Pet::displayRecordTable(const std::map<int, Record>& recordMap, const std::string& recordType) const {
+void Pet::displayRecordTable(const RecordMap& recordMap, const std::string& recordType) const {
     if (recordMap.empty()) {
         std::cout << "No " << recordType << " found for this pet.\n";
         return;
@@ -79,6 +100,7 @@ void Pet::displayRecordTable(const std::map<int, Record>& recordMap, const std::
 
 
 void Pet::displayMedicalHistoryTable() const {
+    loadMedicalHistory();
     if (medicalHistory.empty()) {
         std::cout << "No medical records found for this pet.\n";
         return;
@@ -124,6 +146,7 @@ void Pet::displayPetDetails(const std::vector<Owner>& owners) const {
 
 // vaccinations handling
 void Pet::addVaccination(const std::string& name, const std::string& date, const std::string& status) {
+    rowDirty = true;
     Vaccination vacc(nextVaccinationId++, name, date, status);
     vaccinations.push_back(vacc);
     std::cout << "💉 Vaccination '" << name << "' added with 🆔 " << vacc.getId() << ".\n";
@@ -154,6 +177,7 @@ bool Pet::hasVaccination(int vaccId) const {
     return false;
 }
 void Pet::updateVaccination(int vaccinationId, const std::string& newDate, const std::string& newStatus) {
+    rowDirty = true;
     for (auto& v : vaccinations) {
         if (v.getId() == vaccinationId) {
             v.setDate(newDate);
@@ -178,6 +202,7 @@ const Vaccination* Pet::getVaccinationById(int vaccinationId) const {
 
 
 void Pet::removeVaccination(int vaccId) {
+    rowDirty = true;
     vaccinations.erase(
         std::remove_if(vaccinations.begin(), vaccinations.end(), 
                        [vaccId](const Vaccination& v) { return v.getId() == vaccId; }),
@@ -190,16 +215,21 @@ void Pet::removeVaccination(int vaccId) {
 
 // medical history handling, handled by veterinarians only
 void Pet::addMedicalHistory(const std::string& date, const std::string& details) {
+    loadMedicalHistory();
+    rowDirty = true;
     medicalHistory[nextMedicalRecordId] = Record(date, details, "Pet");
+    textIndex.indexRecord(RecordSource::MedicalHistory, petId, nextMedicalRecordId, details);
     std::cout << "Record added with ID: " << nextMedicalRecordId << "\n";
     nextMedicalRecordId ++;
 }
 
 bool Pet::hasMedicalRecord(int recordId) const {
+    loadMedicalHistory();
     return medicalHistory.find(recordId) != medicalHistory.end();
 }
 
 void Pet::displayFullMedicalRecord(int recordId) const {
+    loadMedicalHistory();
     auto it = medicalHistory.find(recordId);
     if (it != medicalHistory.end()) {
         std::cout << "\n📄 ----- Full Medical Record -----\n";
@@ -215,16 +245,22 @@ void Pet::displayFullMedicalRecord(int recordId) const {
 
 
 
-void Pet::addMedicalHistoryWithId(int id, const std::string& date, const std::string& details) {
-    medicalHistory[id] = Record(date, details, "Pet");
+void Pet::addMedicalHistoryWithId(int id, StoredDate date, std::string_view details) {
+    loadMedicalHistory();
+    rowDirty = true;
+    medicalHistory.insert_or_assign(id, Record(date, ArenaString::inArena(loadedText.store(details)), "Pet"));
     if (id >= nextMedicalRecordId) nextMedicalRecordId = id + 1; // update next id 
 
 }
 
 void Pet::updateMedicalHistory(int recordId, const std::string& newDate, const std::string& newDetails) {
-    if (medicalHistory.find(recordId) != medicalHistory.end()) {
-        medicalHistory[recordId].updateDetails(newDetails);
-        medicalHistory[recordId].updateDate(newDate);
+    loadMedicalHistory();
+    rowDirty = true;
+    auto it = medicalHistory.find(recordId);
+    if (it != medicalHistory.end()) {
+        it->second.updateDetails(newDetails);
+        it->second.updateDate(newDate);
+        textIndex.indexRecord(RecordSource::MedicalHistory, petId, recordId, newDetails);
         std::cout << "✅ Med history " << recordId << " updated successfully.\n";
     } else {
         std::cerr << "❌ Record ID not found!\n";
@@ -232,7 +268,10 @@ void Pet::updateMedicalHistory(int recordId, const std::string& newDate, const s
 }
 
 void Pet::removeMedicalHistory(int recordId) {
+    loadMedicalHistory();
+    rowDirty = true;
     if (medicalHistory.erase(recordId)) {
+        textIndex.removeRecord(RecordSource::MedicalHistory, petId, recordId);
         std::cout << "✅ Med history " << recordId << " removed successfully.\n";
     } else {
         std::cerr << "❌ Record ID not found!\n";
@@ -240,6 +279,7 @@ void Pet::removeMedicalHistory(int recordId) {
 }
 
 void Pet::displayMedicalHistory() const {
+    loadMedicalHistory();
     if (medicalHistory.empty()) {
         std::cout << "❌ No med history found for " << name << ".\n";
     } else {
@@ -253,20 +293,29 @@ void Pet::displayMedicalHistory() const {
 
 // general record handling, handled by staff
 void Pet::addPetRecord(const std::string& date, const std::string& details) {
+    loadPetRecords();
+    rowDirty = true;
     petRecords[nextPetRecordId] = Record(date, details, "Pet");
+    textIndex.indexRecord(RecordSource::PetRecord, petId, nextPetRecordId, details);
     std::cout << "Record added with ID: " << nextPetRecordId << "\n";
     nextPetRecordId ++;
 }
 
-void Pet::addPetRecordWithId(int id, const std::string& date, const std::string& details) {
-    petRecords[id] = Record(date, details, "Pet");
+void Pet::addPetRecordWithId(int id, StoredDate date, std::string_view details) {
+    loadPetRecords();
+    rowDirty = true;
+    petRecords.insert_or_assign(id, Record(date, ArenaString::inArena(loadedText.store(details)), "Pet"));
     if (id >= nextPetRecordId) nextPetRecordId = id + 1;
 }
 
 void Pet::updatePetRecord(int recordId, const std::string& newDate, const std::string& newDetails) {
-    if (petRecords.find(recordId) != petRecords.end()) {
-        petRecords[recordId].updateDetails(newDetails);
-        petRecords[recordId].updateDate(newDate);
+    loadPetRecords();
+    rowDirty = true;
+    auto it = petRecords.find(recordId);
+    if (it != petRecords.end()) {
+        it->second.updateDetails(newDetails);
+        it->second.updateDate(newDate);
+        textIndex.indexRecord(RecordSource::PetRecord, petId, recordId, newDetails);
         std::cout << "✅ Pet record " << recordId << " updated successfully.\n";
     } else {
         std::cerr << "❌ Pet record id not found!\n";
@@ -274,13 +323,17 @@ void Pet::updatePetRecord(int recordId, const std::string& newDate, const std::s
 }
 
 void Pet::removePetRecord(int recordId) {
+    loadPetRecords();
+    rowDirty = true;
     if (petRecords.erase(recordId)) {
+        textIndex.removeRecord(RecordSource::PetRecord, petId, recordId);
         std::cout << "✅ Pet record ID " << recordId << " removed successfully.\n";
     } else {
         std::cerr << "Pet record ID not found!\n";
     }
 }
 void Pet::displayPetRecords() const {
+    loadPetRecords();
     if (petRecords.empty()) {
         std::cout << "❌ No pet record found for " << name << ".\n";
     } else {
@@ -292,6 +345,8 @@ void Pet::displayPetRecords() const {
     }
 }
 void Pet::updatePetRecordDate(int recordId, const std::string& newDate) {
+    loadPetRecords();
+    rowDirty = true;
     auto it = petRecords.find(recordId);
     if (it != petRecords.end()) {
         it->second.setDate(newDate);
@@ -299,15 +354,20 @@ void Pet::updatePetRecordDate(int recordId, const std::string& newDate) {
 }
 
 void Pet::updatePetRecordDetails(int recordId, const std::string& newDetails) {
+    loadPetRecords();
+    rowDirty = true;
     auto it = petRecords.find(recordId);
     if (it != petRecords.end()) {
         it->second.setDetails(newDetails);
+        textIndex.indexRecord(RecordSource::PetRecord, petId, recordId, newDetails);
     }
 }
 
 
-void Pet::addVaccinationWithId(int id, const std::string& name, const std::string& date, const std::string& status) {
+void Pet::addVaccinationWithId(int id, std::string_view name, StoredDate date, std::string_view status) {
+    rowDirty = true;
     vaccinations.emplace_back(id, name, date, status);
+    if (id >= nextVaccinationId) nextVaccinationId = id + 1;
 }
 bool Pet::hasVaccinations() const {
     return !vaccinations.empty();
@@ -331,119 +391,135 @@ void Pet::displayFullVaccination(int vaccId) const {
 
 
 
-std::vector<Pet> Pet::loadFromFile(const std::string& filename) {
-    std::vector<Pet> pets;
-    std::ifstream file(filename);
-    if (!file) {
-        std::cerr << "Error opening file: " << filename << "\n";
-        return pets;
+std::vector<Pet> Pet::loadFromFile(const std::string& filename, int& nextPetId) {
+    // the mapping stays alive as long as any pet still refers to its raw record bytes
+    auto file = std::make_shared<MappedFile>(filename);
+    if (!file->isOpen()) {
+        writeLoadLog("Error opening file: " + filename + "\n");
+        return {};
     }
 
-    std::string line;
-    std::getline(file, line); // skip header
-
-    while (std::getline(file, line)) {
-        // debugging
-        // std::cout << "Processing line: " << line << std::endl;   // <== Add this
-
-        std::stringstream ss(line); // ???
-        std::string petIdStr, name, breed, ageStr, ownerIdStr, vaccStatus, vaccData, medHistData, petRecData;
-        
-        std::getline(ss, petIdStr, ',');
-        std::getline(ss, name, ',');
-        std::getline(ss, breed, ',');
-        std::getline(ss, ageStr, ',');
-        std::getline(ss, ownerIdStr, ',');
-        std::getline(ss, vaccStatus, ',');
-        std::getline(ss, vaccData, ',');
-        std::getline(ss, medHistData, ',');
-        std::getline(ss, petRecData);
-
-        // debugging
-        // std::cout << "petIdStr: '" << petIdStr << "', ageStr: '" << ageStr << "', ownerIdStr: '" << ownerIdStr << "'" << std::endl;
-
-
-        if (petIdStr.empty() || ageStr.empty() || ownerIdStr.empty()) {
-            std::cerr << "Skipping malformed pet record line: " << line << "\n";
-            std::cerr << "Values: petIdStr='" << petIdStr << "' ageStr='" << ageStr << "' ownerIdStr='" << ownerIdStr << "'\n";
-
-            continue;
-        }
-
-        int petId = std::stoi(petIdStr);
-        int age = std::stoi(ageStr);
-        // int ownerId = std::stoi(ownerIdStr);
-        // pets may not always have owners
-        int ownerId;
-        if (ownerIdStr.empty() || ownerIdStr == "-1") {
-            ownerId = -1;
-        } else {
-            ownerId = std::stoi(ownerIdStr);
+    std::string_view text = file->view();
+    size_t pos = 0;
+    nextLine(text, pos); // skip header
+
+    return parseCsvBody<Pet>(text.substr(pos),
+        // record details are only stored when first used, not while parsing
+        [&file](std::string_view line, std::vector<Pet>& pets, std::ostream& log, TextArena&) {
+            return parseCsvLine(line, pets, log, file);
+        },
+        [](const Pet& p) { return p.petId; }, nextPetId, loadedText);
+}
+
+// Splits off the text up to the next delimiter (or the end), like std::getline
+static std::string_view nextField(std::string_view& rest, char delim) {
+    size_t end = rest.find(delim);
+    std::string_view field = rest.substr(0, end);
+    rest.remove_prefix(end == std::string_view::npos ? rest.size() : end + 1);
+    return field;
+}
+
+// Parses a leading integer, allowing surrounding text the way std::stoi does
+static bool parseIntField(std::string_view text, int& value) {
+    while (!text.empty() && std::isspace(static_cast<unsigned char>(text.front()))) text.remove_prefix(1);
+    if (!text.empty() && text.front() == '+') text.remove_prefix(1);
+    auto result = std::from_chars(text.data(), text.data() + text.size(), value);
+    return result.ec == std::errc();
+}
+
+// Parses an "id|date|details;..." column into a record map
+static void parseRecordColumn(std::string_view data, RecordMap& records, int& nextId) {
+    while (!data.empty()) {
+        std::string_view parts = nextField(data, ';');
+        std::string_view idStr = nextField(parts, '|');
+        std::string_view date = nextField(parts, '|');
+        std::string_view details = nextField(parts, '|');
+        int recId;
+        if (!idStr.empty() && parseIntField(idStr, recId)) {
+            // only details with escaped commas need an unescaped copy first
+            std::string_view stored = details.find("[comma]") == std::string_view::npos
+                ? loadedText.store(details) : loadedText.store(unescapeCommas(details));
+            records.insert_or_assign(recId, Record(StoredDate(date), ArenaString::inArena(stored), "Pet"));
+            if (recId >= nextId) nextId = recId + 1;
         }
+    }
+}
 
+void Pet::loadMedicalHistory() const {
+    if (medicalHistoryLoaded) return;
+    parseRecordColumn(rawMedicalHistory, medicalHistory, nextMedicalRecordId);
+    medicalHistoryLoaded = true;
+}
 
+void Pet::loadPetRecords() const {
+    if (petRecordsLoaded) return;
+    parseRecordColumn(rawPetRecords, petRecords, nextPetRecordId);
+    petRecordsLoaded = true;
+}
 
-        Pet pet(petId, name, breed, age, ownerId);
-        pet.vaccin_status = vaccStatus;
-
-       // parse vaccinations
-        std::stringstream vaccStream(vaccData);
-        std::string vaccEntry;
-        while (std::getline(vaccStream, vaccEntry, ';')) {
-            std::stringstream vaccParts(vaccEntry);
-            std::string idStr, vaccName, vaccDate, vaccStatus;
-            std::getline(vaccParts, idStr, '|');
-            std::getline(vaccParts, vaccName, '|');
-            std::getline(vaccParts, vaccDate, '|');
-            std::getline(vaccParts, vaccStatus, '|');
-            if (!idStr.empty()) {
-                int vaccId = std::stoi(idStr);
-                pet.addVaccinationWithId(vaccId, vaccName, vaccDate, vaccStatus);
-                if (vaccId >= pet.nextVaccinationId) pet.nextVaccinationId = vaccId + 1;
-            }
-        }
-
-        // parse med history
-        std::stringstream medStream(medHistData);
-        std::string medEntry; // takes each med record
-        while (std::getline(medStream, medEntry, ';')) { // takes one med record at a time and parses with ";"
-            if (medEntry.empty()) continue;
-            std::stringstream medParts(medEntry); // this one takes one part of one record, id, name ...
-            std::string idStr, date, details;
-            std::getline(medParts, idStr, '|');
-            std::getline(medParts, date, '|');
-            std::getline(medParts, details, '|');
-            details = unescapeCommas(details);
-            if (!idStr.empty()) {
-                pet.addMedicalHistoryWithId(std::stoi(idStr), date, details); 
-            }
-            
+bool Pet::parseCsvLine(std::string_view line, std::vector<Pet>& pets, std::ostream& log,
+                       std::shared_ptr<const void> source) {
+    // the pet keeps views into the line, so the bytes must outlive this call
+    if (!source) {
+        auto copy = std::make_shared<std::string>(line);
+        line = *copy;
+        source = std::move(copy);
+    }
 
-        }
+    std::string_view rest = line;
+    std::string_view petIdStr = nextField(rest, ',');
+    std::string_view name = nextField(rest, ',');
+    std::string_view breed = nextField(rest, ',');
+    std::string_view ageStr = nextField(rest, ',');
+    std::string_view ownerIdStr = nextField(rest, ',');
+    std::string_view vaccStatus = nextField(rest, ',');
+    std::string_view vaccData = nextField(rest, ',');
+    std::string_view medHistData = nextField(rest, ',');
+    std::string_view petRecData = rest;
+
+    int petId = 0, age = 0, ownerId = -1;
+    bool valid = !petIdStr.empty() && !ageStr.empty() && !ownerIdStr.empty()
+                 && parseIntField(petIdStr, petId) && parseIntField(ageStr, age)
+                 && parseIntField(ownerIdStr, ownerId); // pets may not always have owners (-1)
+
+    if (!valid) {
+        log << "Skipping malformed pet record line: " << line << "\n";
+        log << "Values: petIdStr='" << petIdStr << "' ageStr='" << ageStr << "' ownerIdStr='" << ownerIdStr << "'\n";
+
+        return false;
+    }
 
-        // parse pet records
-
-        std::stringstream petRecStream(petRecData);
-        std::string recEntry;
-        while (std::getline(petRecStream, recEntry, ';')) {
-            if (recEntry.empty()) continue;
-            std::stringstream recParts(recEntry);
-            std::string idStr, date, details;
-            std::getline(recParts, idStr, '|');
-            std::getline(recParts, date, '|');
-            std::getline(recParts, details, '|');
-            details = unescapeCommas(details);
-            if (!idStr.empty()) {
-                pet.addPetRecordWithId(std::stoi(idStr), date, details);
-            }
+    Pet pet(petId, std::string(name), std::string(breed), age, ownerId);
+    pet.vaccin_status = std::string(vaccStatus);
+
+    // parse vaccinations: id|name|date|status;...
+    while (!vaccData.empty()) {
+        std::string_view vaccParts = nextField(vaccData, ';');
+        std::string_view idStr = nextField(vaccParts, '|');
+        std::string_view vaccName = nextField(vaccParts, '|');
+        std::string_view vaccDate = nextField(vaccParts, '|');
+        std::string_view status = nextField(vaccParts, '|');
+        int vaccId;
+        if (!idStr.empty() && parseIntField(idStr, vaccId)) {
+            pet.addVaccinationWithId(vaccId, vaccName, StoredDate(vaccDate), status);
         }
+    }
 
-        pets.push_back(pet);
-
+    // medical history and pet records are only parsed when first used
+    pet.rawSource = std::move(source);
+    pet.rawMedicalHistory = medHistData;
+    pet.rawPetRecords = petRecData;
+    pet.medicalHistoryLoaded = medHistData.empty();
+    pet.petRecordsLoaded = petRecData.empty();
+
+    // the line itself is the pet's serialized row, unless its stored status is out of date
+    if (vaccStatus == pet.calculateVaccinationStatus()) {
+        pet.rawLine = line;
+        pet.rowDirty = false;
     }
 
-    file.close();
-    return pets;
+    pets.push_back(std::move(pet));
+    return true;
 }
 
 void Pet::displayAsTableRow(const std::vector<Owner>& owners) const {
@@ -459,14 +535,23 @@ void Pet::displayAsTableRow(const std::vector<Owner>& owners) const {
     std::cout << std::left 
               << std::setw(8) << petId 
               << std::setw(20) << truncatePet(capitalizeWords(name), 20) 
-              << std::setw(21) << truncatePet(capitalizeWords(breed), 20) 
+              << std::setw(21) << truncatePet(capitalizeWords(breed.str()), 20) 
               << std::setw(6) << age 
               << std::setw(20) << truncatePet(capitalizeWords(ownerName), 20) 
               << "\n";
 }
 
 
-void Pet::writeToFileStream(std::ofstream& file) const {
+void Pet::writeToFileStream(std::ostream& file) const {
+    file << csvRow() << "\n";
+}
+
+bool Pet::isRowDirty() const {
+    return rowDirty;
+}
+
+std::string_view Pet::csvRow() const {
+    if (!rowDirty) return rawLine.empty() ? std::string_view(cachedRow) : rawLine;
 
     // serialize vectors into a single string
     std::ostringstream vaccinationsStream;
@@ -477,28 +562,34 @@ void Pet::writeToFileStream(std::ofstream& file) const {
                         << vaccinations[i].getStatus();
         if (i != vaccinations.size() - 1) vaccinationsStream << ";";
     }
-     // Serialize medicalHistory
+     // Serialize medicalHistory (never loaded: its original bytes are still valid)
     std::ostringstream medicalHistoryStream;
-    for (auto it = medicalHistory.begin(); it != medicalHistory.end(); ++it) {
-        medicalHistoryStream << it->first << "|" 
-                             << it->second.getDate() << "|" 
-                             << escapeCommas(it->second.getDetails());
-        auto nextIt = it; ++nextIt;
-        if (nextIt != medicalHistory.end()) medicalHistoryStream << ";";
+    if (!medicalHistoryLoaded) medicalHistoryStream << rawMedicalHistory;
+    bool firstMedicalHistory = true;
+    for (const auto& [id, rec] : medicalHistory) {
+        if (!firstMedicalHistory) medicalHistoryStream << ";";
+        medicalHistoryStream << id << "|" << rec.getDate() << "|" << escapeCommas(rec.getDetails());
+        firstMedicalHistory = false;
     }
 
     // Serialize petRecords
     std::ostringstream petRecordsStream;
-    for (auto it = petRecords.begin(); it != petRecords.end(); ++it) {
-        petRecordsStream << it->first << "|"
-                         << it->second.getDate() << "|"
-                         << escapeCommas(it->second.getDetails());
-        auto nextIt = it; ++nextIt;
-        if (nextIt != petRecords.end()) petRecordsStream << ";";
+    if (!petRecordsLoaded) petRecordsStream << rawPetRecords;
+    bool firstPetRecords = true;
+    for (const auto& [id, rec] : petRecords) {
+        if (!firstPetRecords) petRecordsStream << ";";
+        petRecordsStream << id << "|" << rec.getDate() << "|" << escapeCommas(rec.getDetails());
+        firstPetRecords = false;
     }
 
-    file << petId << "," << name << "," << breed << "," << age << "," << ownerId << "," << calculateVaccinationStatus() << ","
-     << vaccinationsStream.str() << "," << medicalHistoryStream.str() << "," << petRecordsStream.str() << "\n";
+    std::ostringstream row;
+    row << petId << "," << name << "," << breed << "," << age << "," << ownerId << "," << calculateVaccinationStatus() << ","
+     << vaccinationsStream.str() << "," << medicalHistoryStream.str() << "," << petRecordsStream.str();
+
+    cachedRow = row.str();
+    rawLine = std::string_view();
+    rowDirty = false;
+    return cachedRow;
 }
 
 
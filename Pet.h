@@ -3,11 +3,14 @@
 
 #include <vector>
 #include <string>
+#include <string_view>
 #include <map>
+#include <memory>
 #include <fstream>
 #include <sstream>
 #include "Vaccination.h"
 #include "Record.h"
+#include "Symbol.h"
 #include "Owner.h"
 #include "globals.h"
 
@@ -18,20 +21,36 @@ class Owner;
 // Stores basic info, medical/vaccination/general records, and appointment history.
 class Pet {
     int petId;                                // Unique pet ID
-    std::string name, breed;
+    std::string name;
+    Symbol breed;                             // Interned: a few hundred breeds across all pets
     int age;
     int ownerId;                              // Linked owner's ID
     std::string vaccin_status;               // Calculated vaccination status
 
     std::vector<Vaccination> vaccinations;    // Vaccination records
-    std::map<int, Record> medicalHistory;     // Medical records (vet only)
-    std::map<int, Record> petRecords;         // General records (staff)
-    std::vector<Appointment*> appointmentHistory;
+    mutable RecordMap medicalHistory;         // Medical records (vet only), see loadMedicalHistory()
+    mutable RecordMap petRecords;             // General records (staff), see loadPetRecords()
+    std::vector<int> appointmentIds;          // This pet's appointments, ascending; kept by AppointmentIndex
 
-    int nextMedicalRecordId = 1;
-    int nextPetRecordId = 1;
+    mutable int nextMedicalRecordId = 1;
+    mutable int nextPetRecordId = 1;
     int nextVaccinationId = 1;
 
+    // Raw CSV bytes this pet was loaded from, kept alive by rawSource. The record
+    // columns are parsed into the maps only on first use.
+    std::shared_ptr<const void> rawSource;
+    mutable std::string_view rawLine;         // whole row, valid until the pet changes
+    std::string_view rawMedicalHistory, rawPetRecords;
+    mutable bool medicalHistoryLoaded = true;
+    mutable bool petRecordsLoaded = true;
+
+    // Serialized CSV row, reused on save until a setter marks the pet dirty
+    mutable std::string cachedRow;
+    mutable bool rowDirty = true;
+
+    void loadMedicalHistory() const;          // Parses rawMedicalHistory if not done yet
+    void loadPetRecords() const;              // Parses rawPetRecords if not done yet
+
 public:
     // Constructs a new pet with the given details
     Pet(int petId, const std::string& name, const std::string& breed, const int age, int onwerId);
@@ -43,16 +62,17 @@ public:
 
     // Getters
     std::string getName() const;
-    std::string getBreed() const;
+    const std::string& getBreed() const;
     int getAge() const;
     int getPetId() const;
     int getOnwerId() const;
-    const std::map<int, Record>& getPetRecords() const;
-    const std::map<int, Record>& getMedicalHistory() const;
+    const RecordMap& getPetRecords() const;
+    const RecordMap& getMedicalHistory() const;
+    const std::vector<Vaccination>& getVaccinations() const;
 
     // Utility checks
-    bool hasRecords(const std::map<int, Record>& recordMap) const;
-    bool hasRecord(int recordId, const std::map<int, Record>& recordMap) const;
+    bool hasRecords(const RecordMap& recordMap) const;
+    bool hasRecord(int recordId, const RecordMap& recordMap) const;
     bool hasMedicalRecord(int recordId) const;
     bool hasVaccination(int vaccId) const;
     bool hasVaccinations() const;
@@ -61,12 +81,19 @@ public:
     // Updates the owner ID
     void setOwnerId(int newOwnerId);
 
+    // Appointment adjacency (appointment IDs, not saved with the pet);
+    // maintained by AppointmentIndex, see AppointmentIndex::forPet
+    void linkAppointment(int appointmentId);
+    void unlinkAppointment(int appointmentId);
+    void clearAppointments();
+    const std::vector<int>& getAppointmentIds() const;
+
     // Calculates overall vaccination status
     std::string calculateVaccinationStatus() const;
 
     // ===== Medical History (Vet only) =====
     void addMedicalHistory(const std::string& date, const std::string& details);
-    void addMedicalHistoryWithId(int id, const std::string& date, const std::string& details);
+    void addMedicalHistoryWithId(int id, StoredDate date, std::string_view details);
     void updateMedicalHistory(int recordId, const std::string& newDate, const std::string& newDetails);
     void removeMedicalHistory(int recordId);
     void displayMedicalHistory() const;
@@ -75,7 +102,7 @@ public:
 
     // ===== General Records (Staff) =====
     void addPetRecord(const std::string& date, const std::string& details);
-    void addPetRecordWithId(int id, const std::string& date, const std::string& details);
+    void addPetRecordWithId(int id, StoredDate date, std::string_view details);
     void updatePetRecord(int recordId, const std::string& date, const std::string& newDetails);
     void updatePetRecordDate(int recordId, const std::string& newDate);
     void updatePetRecordDetails(int recordId, const std::string& newDetails);
@@ -84,7 +111,7 @@ public:
 
     // ===== Vaccinations =====
     void addVaccination(const std::string& name, const std::string& date, const std::string& status);
-    void addVaccinationWithId(int id, const std::string& name, const std::string& date, const std::string& status);
+    void addVaccinationWithId(int id, std::string_view name, StoredDate date, std::string_view status);
     void updateVaccination(int vaccId, const std::string& newDate, const std::string& newStatus);
     void removeVaccination(int vaccId);
     void displayVaccinationsTable() const;
@@ -92,13 +119,20 @@ public:
     const Vaccination* getVaccinationById(int vaccinationId) const;
 
     // ===== Display and File I/O =====
-    void displayRecordTable(const std::map<int, Record>& recordMap, const std::string& recordType) const;
+    void displayRecordTable(const RecordMap& recordMap, const std::string& recordType) const;
     void displayPetDetails(const std::vector<Owner>& owners) const;
     void displayAsTableRow(const std::vector<Owner>& owners) const;
     std::string truncatePet(const std::string& text, size_t width) const;
 
-    void writeToFileStream(std::ofstream& file) const;
-    static std::vector<Pet> loadFromFile(const std::string& filename); // Loads pet records from file
+    void writeToFileStream(std::ostream& file) const;
+    std::string_view csvRow() const;    // Serialized CSV row (without newline), re-encoded only if the pet changed
+    bool isRowDirty() const;            // True if the next csvRow() call has to re-encode
+    // Loads pet records from file, raising nextPetId past every loaded ID
+    static std::vector<Pet> loadFromFile(const std::string& filename, int& nextPetId);
+    // Parses one CSV row and appends it; problems are reported to log. If source is
+    // given it must own the bytes of line, otherwise the line is copied.
+    static bool parseCsvLine(std::string_view line, std::vector<Pet>& pets, std::ostream& log = std::cerr,
+                             std::shared_ptr<const void> source = nullptr);
 };
 
 // Displays a table header row for pet listings
@@ -0,0 +1,9 @@
+#include "PetIndex.h"
+#include "Pet.h"
+
+void PetIndex::rebuild(const std::vector<Pet>& pets) {
+    clear();
+    for (size_t i = 0; i < pets.size(); ++i) {
+        insert(pets[i].getPetId(), i);
+    }
+}
@@ -0,0 +1,16 @@
+#ifndef PETINDEX_H
+#define PETINDEX_H
+
+#include <vector>
+#include "IdSlotIndex.h"
+
+class Pet;
+
+// Pet ID -> position in a pet vector (see IdSlotIndex)
+class PetIndex : public IdSlotIndex {
+public:
+    // Replaces the contents with the IDs of all pets in the vector
+    void rebuild(const std::vector<Pet>& pets);
+};
+
+#endif  // PETINDEX_H
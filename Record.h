@@ -5,32 +5,42 @@
 #include <string>
 #include <iostream>
 #include <iomanip>
+#include "Symbol.h"
+#include "DateTime.h"
+#include "TextArena.h"
+#include "FlatMap.h"
 
 // Represents a general-purpose record linked to a pet or owner.
-// Stores the date, details, and type of the record (e.g., "Pet", "Owner").
+// Stores the date (packed, see StoredDate), details, and type of the record (e.g., "Pet", "Owner").
 class Record {
-    std::string date;     // Record date (e.g., "2025-04-08")
-    std::string details;  // Description or notes about the record
-    std::string type;     // Type of record ("Pet" or "Owner")
+    StoredDate date;      // Record date (e.g., 2025-04-08)
+    ArenaString details;  // Description or notes about the record; in `loadedText` if read from disk
+    Symbol type;          // Type of record ("Pet" or "Owner"), interned
 
 public:
     // Default constructor
-    Record() : date(""), details(""), type("") {}
+    Record() {}
 
-    // Parameterized constructor
+    // Parameterized constructor (record created at runtime; keeps its own copy of the details)
     Record(const std::string& date, const std::string details, const std::string type) 
-        : date(date), details(details), type(type) {}
+        : date(date), details(details), type(Symbol(type)) {}
+
+    // Record read from disk, whose details were already stored in an arena
+    Record(StoredDate date, ArenaString details, const std::string& type)
+        : date(date), details(std::move(details)), type(Symbol(type)) {}
 
     // Getter methods
-    std::string getDate() const { return date; }
-    std::string getDetails() const { return details; }
-    std::string getType() const { return type; }
+    std::string getDate() const { return date.toString(); }
+    Date getDateValue() const { return date.value(); }
+    std::string getDetails() const { return details.str(); }
+    std::string_view getDetailsView() const { return details.view(); }
+    const std::string& getType() const { return type.str(); }
 
     // Setter methods
-    void updateDetails(const std::string& newDetails) { details = newDetails; }
-    void updateDate(const std::string& newDate) { date = newDate; }
-    void setDate(const std::string& newDate) { date = newDate; }
-    void setDetails(const std::string& newDetails) { details = newDetails; }
+    void updateDetails(const std::string& newDetails) { details = ArenaString(newDetails); }
+    void updateDate(const std::string& newDate) { date = StoredDate(newDate); }
+    void setDate(const std::string& newDate) { date = StoredDate(newDate); }
+    void setDetails(const std::string& newDetails) { details = ArenaString(newDetails); }
 
     // Displays the record as a compact summary (single-line)
     void displayRecord() const {
@@ -57,4 +67,8 @@ public:
     }
 };
 
+// A pet's or owner's records by record ID. IDs come from a per-entity counter,
+// so new records append to the end of the flat map.
+using RecordMap = FlatMap<int, Record>;
+
 #endif
@@ -0,0 +1,272 @@
+#include "RoaringBitmap.h"
+#include <algorithm>
+#include <iterator>
+
+// Plain loops over whole words: with optimization on, compilers unroll and
+// vectorize these (and the popcounts in them) for the target CPU.
+static uint32_t andWords(const uint64_t* a, const uint64_t* b, uint64_t* out, size_t n) {
+    uint32_t count = 0;
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = a[i] & b[i];
+        count += static_cast<uint32_t>(__builtin_popcountll(out[i]));
+    }
+    return count;
+}
+
+static uint32_t orWords(const uint64_t* a, const uint64_t* b, uint64_t* out, size_t n) {
+    uint32_t count = 0;
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = a[i] | b[i];
+        count += static_cast<uint32_t>(__builtin_popcountll(out[i]));
+    }
+    return count;
+}
+
+static uint32_t andCountWords(const uint64_t* a, const uint64_t* b, size_t n) {
+    uint32_t count = 0;
+    for (size_t i = 0; i < n; ++i) count += static_cast<uint32_t>(__builtin_popcountll(a[i] & b[i]));
+    return count;
+}
+
+bool RoaringBitmap::Container::contains(uint16_t low) const {
+    if (isBitmap()) return (words[low >> 6] >> (low & 63)) & 1;
+    return std::binary_search(values.begin(), values.end(), low);
+}
+
+void RoaringBitmap::Container::toBitmap() {
+    words.assign(BITMAP_WORDS, 0);
+    for (uint16_t low : values) words[low >> 6] |= uint64_t{1} << (low & 63);
+    values.clear();
+    values.shrink_to_fit();
+}
+
+void RoaringBitmap::Container::toArray() {
+    values.clear();
+    values.reserve(cardinality);
+    for (size_t i = 0; i < BITMAP_WORDS; ++i) {
+        for (uint64_t w = words[i]; w; w &= w - 1) {
+            values.push_back(static_cast<uint16_t>(i * 64 + __builtin_ctzll(w)));
+        }
+    }
+    words.clear();
+    words.shrink_to_fit();
+}
+
+void RoaringBitmap::Container::fit() {
+    if (isBitmap() && cardinality <= ARRAY_LIMIT) toArray();
+    else if (!isBitmap() && cardinality > ARRAY_LIMIT) toBitmap();
+}
+
+bool RoaringBitmap::add(uint32_t id) {
+    uint16_t high = static_cast<uint16_t>(id >> 16), low = static_cast<uint16_t>(id);
+    auto key = std::lower_bound(keys.begin(), keys.end(), high);
+    size_t i = key - keys.begin();
+    if (key == keys.end() || *key != high) {
+        keys.insert(key, high);
+        containers.insert(containers.begin() + i, Container{});
+    }
+
+    Container& c = containers[i];
+    if (c.isBitmap()) {
+        uint64_t& word = c.words[low >> 6];
+        uint64_t bit = uint64_t{1} << (low & 63);
+        if (word & bit) return false;
+        word |= bit;
+    } else {
+        auto it = std::lower_bound(c.values.begin(), c.values.end(), low);
+        if (it != c.values.end() && *it == low) return false;
+        c.values.insert(it, low);
+    }
+    c.cardinality++;
+    c.fit();
+    return true;
+}
+
+bool RoaringBitmap::remove(uint32_t id) {
+    uint16_t high = static_cast<uint16_t>(id >> 16), low = static_cast<uint16_t>(id);
+    auto key = std::lower_bound(keys.begin(), keys.end(), high);
+    if (key == keys.end() || *key != high) return false;
+    size_t i = key - keys.begin();
+
+    Container& c = containers[i];
+    if (c.isBitmap()) {
+        uint64_t& word = c.words[low >> 6];
+        uint64_t bit = uint64_t{1} << (low & 63);
+        if (!(word & bit)) return false;
+        word &= ~bit;
+    } else {
+        auto it = std::lower_bound(c.values.begin(), c.values.end(), low);
+        if (it == c.values.end() || *it != low) return false;
+        c.values.erase(it);
+    }
+
+    if (--c.cardinality == 0) {
+        keys.erase(key);
+        containers.erase(containers.begin() + i);
+    } else {
+        c.fit();
+    }
+    return true;
+}
+
+bool RoaringBitmap::contains(uint32_t id) const {
+    uint16_t high = static_cast<uint16_t>(id >> 16);
+    auto key = std::lower_bound(keys.begin(), keys.end(), high);
+    if (key == keys.end() || *key != high) return false;
+    return containers[key - keys.begin()].contains(static_cast<uint16_t>(id));
+}
+
+void RoaringBitmap::clear() {
+    keys.clear();
+    containers.clear();
+}
+
+uint64_t RoaringBitmap::cardinality() const {
+    uint64_t total = 0;
+    for (const auto& c : containers) total += c.cardinality;
+    return total;
+}
+
+RoaringBitmap::Container RoaringBitmap::intersect(const Container& a, const Container& b) {
+    Container out;
+    if (a.isBitmap() && b.isBitmap()) {
+        out.words.resize(BITMAP_WORDS);
+        out.cardinality = andWords(a.words.data(), b.words.data(), out.words.data(), BITMAP_WORDS);
+        out.fit();
+    } else if (a.isBitmap() || b.isBitmap()) {
+        const Container& array = a.isBitmap() ? b : a;
+        const Container& bitmap = a.isBitmap() ? a : b;
+        for (uint16_t low : array.values) {
+            if (bitmap.contains(low)) out.values.push_back(low);
+        }
+        out.cardinality = static_cast<uint32_t>(out.values.size());
+    } else {
+        std::set_intersection(a.values.begin(), a.values.end(), b.values.begin(), b.values.end(),
+                              std::back_inserter(out.values));
+        out.cardinality = static_cast<uint32_t>(out.values.size());
+    }
+    return out;
+}
+
+RoaringBitmap::Container RoaringBitmap::unite(const Container& a, const Container& b) {
+    Container out;
+    if (a.isBitmap() && b.isBitmap()) {
+        out.words.resize(BITMAP_WORDS);
+        out.cardinality = orWords(a.words.data(), b.words.data(), out.words.data(), BITMAP_WORDS);
+    } else if (a.isBitmap() || b.isBitmap()) {
+        const Container& array = a.isBitmap() ? b : a;
+        out = a.isBitmap() ? a : b;
+        for (uint16_t low : array.values) {
+            uint64_t& word = out.words[low >> 6];
+            uint64_t bit = uint64_t{1} << (low & 63);
+            if (!(word & bit)) {
+                word |= bit;
+                out.cardinality++;
+            }
+        }
+    } else {
+        std::set_union(a.values.begin(), a.values.end(), b.values.begin(), b.values.end(),
+                       std::back_inserter(out.values));
+        out.cardinality = static_cast<uint32_t>(out.values.size());
+        out.fit();
+    }
+    return out;
+}
+
+uint32_t RoaringBitmap::intersectCount(const Container& a, const Container& b) {
+    if (a.isBitmap() && b.isBitmap()) return andCountWords(a.words.data(), b.words.data(), BITMAP_WORDS);
+
+    if (a.isBitmap() || b.isBitmap()) {
+        const Container& array = a.isBitmap() ? b : a;
+        const Container& bitmap = a.isBitmap() ? a : b;
+        uint32_t count = 0;
+        for (uint16_t low : array.values) count += bitmap.contains(low);
+        return count;
+    }
+
+    uint32_t count = 0;
+    auto i = a.values.begin(), j = b.values.begin();
+    while (i != a.values.end() && j != b.values.end()) {
+        if (*i < *j) ++i;
+        else if (*j < *i) ++j;
+        else { ++count; ++i; ++j; }
+    }
+    return count;
+}
+
+RoaringBitmap RoaringBitmap::operator&(const RoaringBitmap& other) const {
+    RoaringBitmap out;
+    size_t i = 0, j = 0;
+    while (i < keys.size() && j < other.keys.size()) {
+        if (keys[i] < other.keys[j]) {
+            ++i;
+        } else if (other.keys[j] < keys[i]) {
+            ++j;
+        } else {
+            Container c = intersect(containers[i], other.containers[j]);
+            if (c.cardinality) {
+                out.keys.push_back(keys[i]);
+                out.containers.push_back(std::move(c));
+            }
+            ++i;
+            ++j;
+        }
+    }
+    return out;
+}
+
+RoaringBitmap RoaringBitmap::operator|(const RoaringBitmap& other) const {
+    RoaringBitmap out;
+    size_t i = 0, j = 0;
+    while (i < keys.size() || j < other.keys.size()) {
+        if (j == other.keys.size() || (i < keys.size() && keys[i] < other.keys[j])) {
+            out.keys.push_back(keys[i]);
+            out.containers.push_back(containers[i++]);
+        } else if (i == keys.size() || other.keys[j] < keys[i]) {
+            out.keys.push_back(other.keys[j]);
+            out.containers.push_back(other.containers[j++]);
+        } else {
+            out.keys.push_back(keys[i]);
+            out.containers.push_back(unite(containers[i++], other.containers[j++]));
+        }
+    }
+    return out;
+}
+
+uint64_t RoaringBitmap::andCardinality(const RoaringBitmap& other) const {
+    uint64_t count = 0;
+    size_t i = 0, j = 0;
+    while (i < keys.size() && j < other.keys.size()) {
+        if (keys[i] < other.keys[j]) ++i;
+        else if (other.keys[j] < keys[i]) ++j;
+        else count += intersectCount(containers[i++], other.containers[j++]);
+    }
+    return count;
+}
+
+std::vector<uint32_t> RoaringBitmap::toVector() const {
+    std::vector<uint32_t> ids;
+    ids.reserve(cardinality());
+    for (size_t i = 0; i < keys.size(); ++i) {
+        uint32_t high = static_cast<uint32_t>(keys[i]) << 16;
+        const Container& c = containers[i];
+        if (c.isBitmap()) {
+            for (size_t w = 0; w < BITMAP_WORDS; ++w) {
+                for (uint64_t word = c.words[w]; word; word &= word - 1) {
+                    ids.push_back(high | static_cast<uint32_t>(w * 64 + __builtin_ctzll(word)));
+                }
+            }
+        } else {
+            for (uint16_t low : c.values) ids.push_back(high | low);
+        }
+    }
+    return ids;
+}
+
+size_t RoaringBitmap::memoryUsage() const {
+    size_t bytes = keys.capacity() * sizeof(uint16_t) + containers.capacity() * sizeof(Container);
+    for (const auto& c : containers) {
+        bytes += c.values.capacity() * sizeof(uint16_t) + c.words.capacity() * sizeof(uint64_t);
+    }
+    return bytes;
+}
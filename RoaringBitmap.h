@@ -0,0 +1,63 @@
+#ifndef ROARINGBITMAP_H
+#define ROARINGBITMAP_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// Compressed set of 32-bit IDs in the style of Roaring bitmaps.
+// IDs are grouped by their high 16 bits; each group ("container") holds its
+// low 16 bits either as a sorted array (up to ARRAY_LIMIT values, 2 bytes each)
+// or as a 65536-bit bitmap (8 KiB), whichever is smaller. Dense groups are
+// then combined a 64-bit word at a time: AND/OR are word loops and counts are
+// popcounts, which the compiler turns into vector code where the CPU has it.
+class RoaringBitmap {
+public:
+    static constexpr size_t ARRAY_LIMIT = 4096;
+    static constexpr size_t BITMAP_WORDS = 65536 / 64;
+
+private:
+    struct Container {
+        std::vector<uint16_t> values;   // sorted low bits, while an array container
+        std::vector<uint64_t> words;    // BITMAP_WORDS words, once a bitmap container
+        uint32_t cardinality = 0;
+
+        bool isBitmap() const { return !words.empty(); }
+        bool contains(uint16_t low) const;
+        void toBitmap();
+        void toArray();
+        void fit();   // picks the smaller representation for the cardinality
+    };
+
+    std::vector<uint16_t> keys;            // high 16 bits, ascending
+    std::vector<Container> containers;     // parallel to keys
+
+    static Container intersect(const Container& a, const Container& b);
+    static Container unite(const Container& a, const Container& b);
+    static uint32_t intersectCount(const Container& a, const Container& b);
+
+public:
+    // Adds / removes one ID; both return false if nothing changed
+    bool add(uint32_t id);
+    bool remove(uint32_t id);
+    bool contains(uint32_t id) const;
+
+    void clear();
+    bool empty() const { return keys.empty(); }
+    uint64_t cardinality() const;
+
+    // Set intersection / union
+    RoaringBitmap operator&(const RoaringBitmap& other) const;
+    RoaringBitmap operator|(const RoaringBitmap& other) const;
+
+    // Size of the intersection, without building it
+    uint64_t andCardinality(const RoaringBitmap& other) const;
+
+    // The IDs in ascending order
+    std::vector<uint32_t> toVector() const;
+
+    // Approximate heap bytes held by the containers
+    size_t memoryUsage() const;
+};
+
+#endif  // ROARINGBITMAP_H
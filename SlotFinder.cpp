@@ -0,0 +1,62 @@
+#include "SlotFinder.h"
+#include "validations.h"
+#include <ctime>
+#include <algorithm>
+
+// Index of the lowest set bit; `bits` must not be 0
+static int lowestBit(uint64_t bits) {
+#if defined(__GNUC__)
+    return __builtin_ctzll(bits);
+#else
+    int index = 0;
+    while (!(bits & 1)) {
+        bits >>= 1;
+        index++;
+    }
+    return index;
+#endif
+}
+
+std::vector<FreeSlot> findFreeSlots(const AppointmentIndex& index, const std::string& earliestDate, size_t count,
+                                    int durationMinutes, int maxDays) {
+    std::vector<FreeSlot> slots;
+    Date first = Date::parse(earliestDate);
+    if (!first.valid() || count == 0 || durationMinutes <= 0) return slots;
+
+    const int S = AppointmentIndex::SLOT_MINUTES;
+    const int slotsNeeded = (durationMinutes + S - 1) / S;
+    if (slotsNeeded > AppointmentIndex::SLOTS_PER_DAY) return slots;
+    const uint64_t openMask = (uint64_t{1} << AppointmentIndex::SLOTS_PER_DAY) - 1;
+
+    time_t now = time(0);
+    tm* localTime = localtime(&now);
+    int minuteNow = localTime->tm_hour * 60 + localTime->tm_min;
+    Date today = Date::today();
+
+    // never suggest days in the past
+    Date firstDay = std::max(first, today);
+    for (Date day = firstDay; day < firstDay.plusDays(maxDays) && slots.size() < count; day = day.plusDays(1)) {
+        if (day.isWeekend()) continue;
+
+        uint64_t free = ~index.busySlots(day.daysSinceEpoch()) & openMask;
+        if (day == today) {
+            // drop slots that have already started
+            int started = (minuteNow - AppointmentIndex::OPENING_MINUTE + S - 1) / S;
+            if (started >= AppointmentIndex::SLOTS_PER_DAY) continue;
+            if (started > 0) free &= ~((uint64_t{1} << started) - 1);
+        }
+
+        // bit i survives if slots i .. i + slotsNeeded - 1 are all free
+        uint64_t fits = free;
+        for (int k = 1; k < slotsNeeded; ++k) fits &= free >> k;
+
+        while (fits && slots.size() < count) {
+            int slot = lowestBit(fits);
+            fits &= fits - 1;
+
+            TimeOfDay start = TimeOfDay::fromMinutes(AppointmentIndex::OPENING_MINUTE + slot * S);
+            slots.push_back(FreeSlot{ day.toString(), start.toString() });
+        }
+    }
+    return slots;
+}
@@ -0,0 +1,24 @@
+#ifndef SLOTFINDER_H
+#define SLOTFINDER_H
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include "AppointmentIndex.h"
+
+// A bookable start time
+struct FreeSlot {
+    std::string date;   // YYYY-MM-DD
+    std::string time;   // HH:MM
+};
+
+// Next `count` start times, on the 15-minute grid during opening hours, where
+// an appointment of durationMinutes overlaps no booked appointment.
+// Searches from earliestDate (skipping times already past today) for at most
+// maxDays days; weekends are skipped, as for manual booking (see isWeekend).
+// Each day is one 64-bit word of busy slots, so a day is checked with a few
+// shifts and bit scans rather than by trying times one by one.
+std::vector<FreeSlot> findFreeSlots(const AppointmentIndex& index, const std::string& earliestDate, size_t count,
+                                    int durationMinutes = AppointmentIndex::APPOINTMENT_MINUTES, int maxDays = 366);
+
+#endif  // SLOTFINDER_H
@@ -0,0 +1,59 @@
+#include "StatusIndex.h"
+#include "validations.h"
+#include "globals.h"
+#include <iterator>
+#include <algorithm>
+
+void StatusIndex::assign(int id, const std::vector<std::string>& values) {
+    remove(id);
+    if (values.empty()) return;
+
+    uint32_t code = Symbol(toLower(values.front())).getId();
+    for (const auto& value : values) {
+        uint32_t valueCode = Symbol(toLower(value)).getId();
+        byValue[valueCode].add(static_cast<uint32_t>(id));
+        if (valueCode != code) code = SEVERAL;
+    }
+    valueOf[id] = code;
+}
+
+void StatusIndex::remove(int id) {
+    auto it = valueOf.find(id);
+    if (it == valueOf.end()) return;
+    uint32_t code = it->second;
+    valueOf.erase(it);
+
+    auto removeFrom = [this, id](std::unordered_map<uint32_t, RoaringBitmap>::iterator bitmap) {
+        bitmap->second.remove(static_cast<uint32_t>(id));
+        return bitmap->second.empty() ? byValue.erase(bitmap) : std::next(bitmap);
+    };
+
+    if (code != SEVERAL) {
+        auto bitmap = byValue.find(code);
+        if (bitmap != byValue.end()) removeFrom(bitmap);
+        return;
+    }
+    for (auto bitmap = byValue.begin(); bitmap != byValue.end();) bitmap = removeFrom(bitmap);
+}
+
+void StatusIndex::clear() {
+    byValue.clear();
+    valueOf.clear();
+}
+
+const RoaringBitmap& StatusIndex::with(const std::string& value) const {
+    static const RoaringBitmap none;
+    auto it = byValue.find(Symbol(toLower(value)).getId());
+    return it == byValue.end() ? none : it->second;
+}
+
+uint64_t StatusIndex::count(const std::string& value) const {
+    return with(value).cardinality();
+}
+
+std::vector<std::string> StatusIndex::values() const {
+    std::vector<std::string> names;
+    for (const auto& entry : byValue) names.push_back(symbols.text(entry.first));
+    std::sort(names.begin(), names.end());
+    return names;
+}
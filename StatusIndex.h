@@ -0,0 +1,45 @@
+#ifndef STATUSINDEX_H
+#define STATUSINDEX_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include "RoaringBitmap.h"
+
+// One bitmap of IDs per value of a categorical field (appointment status,
+// vaccination status, ...). Values are compared lower-cased. An ID can carry
+// several values at once, e.g. a pet with one "completed" and one "pending"
+// vaccination. Counting, and combining with other filters, is then bitwise
+// AND/OR over the bitmaps instead of a string comparison per record.
+//
+// Values are keyed by their interned Symbol number, and each ID keeps only that
+// 4-byte code to find its bitmap again on update. IDs carrying several values
+// are marked SEVERAL and removed by checking every bitmap, which is cheap for a
+// categorical field with a handful of values.
+class StatusIndex {
+    static constexpr uint32_t SEVERAL = UINT32_MAX;
+
+    std::unordered_map<uint32_t, RoaringBitmap> byValue;   // Symbol number of the value -> IDs
+    std::unordered_map<int, uint32_t> valueOf;              // ID -> Symbol number, or SEVERAL
+
+public:
+    // Sets the values an ID carries, replacing any it had
+    void assign(int id, const std::vector<std::string>& values);
+
+    // Forgets an ID; call when the record is deleted
+    void remove(int id);
+
+    void clear();
+
+    // IDs carrying the value (empty bitmap if none)
+    const RoaringBitmap& with(const std::string& value) const;
+
+    // Number of IDs carrying the value
+    uint64_t count(const std::string& value) const;
+
+    // Every value currently carried by at least one ID, alphabetically
+    std::vector<std::string> values() const;
+};
+
+#endif  // STATUSINDEX_H
@@ -0,0 +1,57 @@
+#include "Symbol.h"
+#include "globals.h"
+#include <mutex>
+#include <stdexcept>
+#include <ostream>
+
+SymbolTable::SymbolTable() {
+    chunks[0].reset(new const std::string*[CHUNK_SIZE]);
+    texts.emplace_back();
+    chunks[0][0] = &texts.back();
+    ids.emplace(texts.back(), 0);
+}
+
+uint32_t SymbolTable::intern(std::string_view text) {
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        auto it = ids.find(text);
+        if (it != ids.end()) return it->second;
+    }
+
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    auto it = ids.find(text);   // another thread may have added it meanwhile
+    if (it != ids.end()) return it->second;
+
+    uint32_t id = count;
+    size_t chunk = id / CHUNK_SIZE;
+    if (chunk >= MAX_CHUNKS) throw std::length_error("symbol table is full");
+    if (!chunks[chunk]) chunks[chunk].reset(new const std::string*[CHUNK_SIZE]);
+
+    texts.emplace_back(text);
+    chunks[chunk][id % CHUNK_SIZE] = &texts.back();
+    ids.emplace(texts.back(), id);
+    count++;
+    return id;
+}
+
+size_t SymbolTable::size() const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return count - 1;
+}
+
+size_t SymbolTable::textBytes() const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    size_t bytes = 0;
+    for (const auto& text : texts) bytes += text.size();
+    return bytes;
+}
+
+Symbol::Symbol(std::string_view text) : id(text.empty() ? 0 : symbols.intern(text)) {}
+
+const std::string& Symbol::str() const {
+    return symbols.text(id);
+}
+
+std::ostream& operator<<(std::ostream& out, Symbol symbol) {
+    return out << symbol.str();
+}
@@ -0,0 +1,70 @@
+#ifndef SYMBOL_H
+#define SYMBOL_H
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <deque>
+#include <memory>
+#include <shared_mutex>
+#include <cstdint>
+#include <cstddef>
+
+// Pool of distinct strings for fields that repeat a handful of values across
+// many rows (breeds, vaccine names, statuses, record types). Each distinct
+// text is stored once and numbered from 1 (0 is the empty string); numbers
+// never change, so a field can hold the 4-byte number instead of a copy.
+//
+// Interning takes a shared lock for texts already in the pool and a unique
+// lock only to add a new one, so the parallel loaders can intern at once.
+// Looking a number up takes no lock: texts live in fixed-size chunks that are
+// never moved, and a number is only handed out after its text is in place.
+class SymbolTable {
+public:
+    static constexpr size_t CHUNK_SIZE = 4096;
+    static constexpr size_t MAX_CHUNKS = 1024;
+
+private:
+    mutable std::shared_mutex mutex;
+    std::unordered_map<std::string_view, uint32_t> ids;   // views into `texts`
+    std::deque<std::string> texts;                         // stable addresses
+    std::unique_ptr<const std::string*[]> chunks[MAX_CHUNKS];
+    uint32_t count = 1;                                    // next number to hand out
+
+public:
+    SymbolTable();
+
+    // The number of the text, adding it to the pool if needed
+    uint32_t intern(std::string_view text);
+
+    // The text of a number handed out by intern()
+    const std::string& text(uint32_t id) const {
+        return *chunks[id / CHUNK_SIZE][id % CHUNK_SIZE];
+    }
+
+    // Distinct texts in the pool, and their total length
+    size_t size() const;
+    size_t textBytes() const;
+};
+
+// A string field stored as its number in the global `symbols` pool.
+// Two Symbols are equal exactly when their texts are equal, so comparing
+// them is one integer comparison.
+class Symbol {
+    uint32_t id = 0;
+
+public:
+    Symbol() = default;
+    explicit Symbol(std::string_view text);
+
+    const std::string& str() const;
+    uint32_t getId() const { return id; }
+    bool empty() const { return id == 0; }
+
+    bool operator==(Symbol other) const { return id == other.id; }
+    bool operator!=(Symbol other) const { return id != other.id; }
+};
+
+std::ostream& operator<<(std::ostream& out, Symbol symbol);
+
+#endif  // SYMBOL_H
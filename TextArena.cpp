@@ -0,0 +1,79 @@
+#include "TextArena.h"
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <ostream>
+
+std::string_view TextArena::store(std::string_view text) {
+    if (text.empty()) return std::string_view();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (blocks.empty() || blockSize - blockUsed < text.size()) {
+        size_t next = blocks.empty() ? FIRST_BLOCK : std::min(blockSize * 2, MAX_BLOCK);
+        blockSize = std::max(next, text.size());
+        blocks.emplace_back(new char[blockSize]);
+        blockUsed = 0;
+        reserved += blockSize;
+    }
+
+    char* at = blocks.back().get() + blockUsed;
+    std::memcpy(at, text.data(), text.size());
+    blockUsed += text.size();
+    used += text.size();
+    stored++;
+    return std::string_view(at, text.size());
+}
+
+void TextArena::adopt(TextArena& other) {
+    if (&other == this) return;
+    std::scoped_lock lock(mutex, other.mutex);
+    if (other.blocks.empty()) return;
+
+    if (blocks.empty()) {
+        // nothing of our own yet: continue filling the adopted last block
+        blocks = std::move(other.blocks);
+        blockSize = other.blockSize;
+        blockUsed = other.blockUsed;
+    } else {
+        // keep our own last block as the one being filled
+        blocks.insert(blocks.end() - 1, std::make_move_iterator(other.blocks.begin()),
+                      std::make_move_iterator(other.blocks.end()));
+    }
+    reserved += other.reserved;
+    used += other.used;
+    stored += other.stored;
+
+    other.blocks.clear();
+    other.blockSize = other.blockUsed = other.reserved = other.used = other.stored = 0;
+}
+
+void TextArena::release() {
+    std::lock_guard<std::mutex> lock(mutex);
+    blocks.clear();
+    blocks.shrink_to_fit();
+    blockSize = blockUsed = reserved = used = stored = 0;
+}
+
+size_t TextArena::bytesUsed() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return used;
+}
+
+size_t TextArena::bytesReserved() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return reserved;
+}
+
+size_t TextArena::blockCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return blocks.size();
+}
+
+size_t TextArena::textCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return stored;
+}
+
+std::ostream& operator<<(std::ostream& out, const ArenaString& s) {
+    return out << s.view();
+}
@@ -0,0 +1,85 @@
+#ifndef TEXTARENA_H
+#define TEXTARENA_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <cstddef>
+#include <iosfwd>
+
+// Monotonic store for free text read from disk (record details).
+// Texts are copied end to end into a few large blocks instead of one heap
+// allocation each; nothing is freed individually, and all blocks go at once
+// when the arena is released or destroyed. Block sizes double from
+// FIRST_BLOCK up to MAX_BLOCK, so even large files take only a handful.
+//
+// Storing is locked, but parallel parsers do not share an arena: each parse
+// chunk fills its own and the loaded arena adopts its blocks once the chunk is
+// done (see parseCsvBody), so the loader threads never wait on each other here.
+class TextArena {
+public:
+    static constexpr size_t FIRST_BLOCK = 64 * 1024;
+    static constexpr size_t MAX_BLOCK = 4 * 1024 * 1024;
+
+private:
+    mutable std::mutex mutex;
+    std::vector<std::unique_ptr<char[]>> blocks;
+    size_t blockSize = 0;      // size of the last block
+    size_t blockUsed = 0;      // bytes taken in the last block
+    size_t reserved = 0;       // total of all block sizes
+    size_t used = 0;           // total bytes stored
+    size_t stored = 0;         // number of texts stored
+
+public:
+    TextArena() = default;
+    TextArena(const TextArena&) = delete;
+    TextArena& operator=(const TextArena&) = delete;
+
+    // Copies the text into the arena; the view stays valid until release()
+    std::string_view store(std::string_view text);
+
+    // Takes over every block of `other` (the texts stay where they are, so views
+    // into them remain valid) and leaves `other` empty
+    void adopt(TextArena& other);
+
+    // Frees every block. Only call once nothing refers into the arena any more
+    // (e.g. before reloading everything from disk).
+    void release();
+
+    size_t bytesUsed() const;
+    size_t bytesReserved() const;
+    size_t blockCount() const;
+    size_t textCount() const;
+};
+
+// Text held either in a TextArena (as loaded) or in its own buffer (once
+// created or edited at runtime). Copies share the same bytes, and assigning
+// new text never writes into the arena: the field is switched to a fresh
+// owned copy instead, so loaded text stays untouched.
+class ArenaString {
+    std::string_view text;                       // arena bytes, or *owned
+    std::shared_ptr<const std::string> owned;    // set for runtime text
+
+public:
+    ArenaString() = default;
+    explicit ArenaString(const std::string& value)
+        : owned(std::make_shared<const std::string>(value)) { text = *owned; }
+
+    // Wraps text returned by TextArena::store
+    static ArenaString inArena(std::string_view stored) {
+        ArenaString s;
+        s.text = stored;
+        return s;
+    }
+
+    std::string_view view() const { return text; }
+    std::string str() const { return std::string(text); }
+    bool empty() const { return text.empty(); }
+    bool isOwned() const { return owned != nullptr; }
+};
+
+std::ostream& operator<<(std::ostream& out, const ArenaString& s);
+
+#endif  // TEXTARENA_H
@@ -0,0 +1,267 @@
+#include "TextIndex.h"
+#include "Pet.h"
+#include "Owner.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <climits>
+
+// Stands in for a query term that occurs in no record
+static const uint32_t UNKNOWN_TERM = UINT32_MAX;
+
+// BM25 parameters
+static const double K1 = 1.2;
+static const double B = 0.75;
+
+std::vector<std::string> TextIndex::tokenize(std::string_view text) {
+    std::vector<std::string> tokens;
+    std::string current;
+    for (char ch : text) {
+        unsigned char c = static_cast<unsigned char>(ch);
+        if (std::isalnum(c) || c >= 0x80) {
+            current += static_cast<char>(std::tolower(c));
+        } else if (!current.empty()) {
+            tokens.push_back(std::move(current));
+            current.clear();
+        }
+    }
+    if (!current.empty()) tokens.push_back(std::move(current));
+    return tokens;
+}
+
+uint64_t TextIndex::keyOf(RecordSource source, int entityId, int recordId) {
+    // IDs are positive ints, so 31 bits each leave room for the 2-bit source
+    return (static_cast<uint64_t>(source) << 62)
+         | (static_cast<uint64_t>(entityId & INT_MAX) << 31)
+         | static_cast<uint64_t>(recordId & INT_MAX);
+}
+
+uint32_t TextIndex::termId(const std::string& term) {
+    auto [it, inserted] = termIds.emplace(term, static_cast<uint32_t>(postings.size()));
+    if (inserted) {
+        postings.emplace_back();
+        liveFrequency.push_back(0);
+    }
+    return it->second;
+}
+
+// Sorted copy without duplicates (distinct term IDs, or distinct document numbers)
+static std::vector<uint32_t> sortedUnique(const std::vector<uint32_t>& terms) {
+    std::vector<uint32_t> distinct = terms;
+    std::sort(distinct.begin(), distinct.end());
+    distinct.erase(std::unique(distinct.begin(), distinct.end()), distinct.end());
+    return distinct;
+}
+
+void TextIndex::retire(uint32_t doc) {
+    Document& d = documents[doc];
+    for (uint32_t t : sortedUnique(d.terms)) liveFrequency[t]--;
+    liveDocuments--;
+    liveTerms -= d.terms.size();
+    d.live = false;
+    d.terms.clear();
+    d.terms.shrink_to_fit();
+}
+
+void TextIndex::compactIfSparse() {
+    size_t retired = documents.size() - liveDocuments;
+    if (retired < 1024 || retired < liveDocuments) return;
+
+    // Renumbering keeps the relative order, so posting lists stay sorted
+    std::vector<uint32_t> renumbered(documents.size(), UINT32_MAX);
+    std::vector<Document> kept;
+    kept.reserve(liveDocuments);
+    for (size_t i = 0; i < documents.size(); ++i) {
+        if (!documents[i].live) continue;
+        renumbered[i] = static_cast<uint32_t>(kept.size());
+        kept.push_back(std::move(documents[i]));
+    }
+
+    for (auto& list : postings) {
+        size_t out = 0;
+        for (uint32_t doc : list) {
+            if (renumbered[doc] != UINT32_MAX) list[out++] = renumbered[doc];
+        }
+        list.resize(out);
+    }
+    for (auto& entry : documentOf) entry.second = renumbered[entry.second];
+    documents = std::move(kept);
+}
+
+void TextIndex::build(const std::vector<Pet>& pets, const std::vector<Owner>& owners) {
+    documents.clear();
+    termIds.clear();
+    postings.clear();
+    liveFrequency.clear();
+    documentOf.clear();
+    liveDocuments = 0;
+    liveTerms = 0;
+    built = true;
+
+    for (const auto& pet : pets) {
+        for (const auto& [id, record] : pet.getMedicalHistory()) {
+            indexRecord(RecordSource::MedicalHistory, pet.getPetId(), id, record.getDetails());
+        }
+        for (const auto& [id, record] : pet.getPetRecords()) {
+            indexRecord(RecordSource::PetRecord, pet.getPetId(), id, record.getDetails());
+        }
+    }
+    for (const auto& owner : owners) {
+        for (const auto& [id, record] : owner.getRecords()) {
+            indexRecord(RecordSource::OwnerRecord, owner.getOwnerId(), id, record.getDetails());
+        }
+    }
+}
+
+void TextIndex::indexRecord(RecordSource source, int entityId, int recordId, const std::string& details) {
+    if (!built) return;
+
+    uint64_t key = keyOf(source, entityId, recordId);
+    auto existing = documentOf.find(key);
+    if (existing != documentOf.end()) retire(existing->second);
+
+    Document doc{ source, entityId, recordId, {}, true };
+    for (const auto& token : tokenize(details)) doc.terms.push_back(termId(token));
+
+    uint32_t number = static_cast<uint32_t>(documents.size());
+    for (uint32_t t : sortedUnique(doc.terms)) {
+        postings[t].push_back(number);
+        liveFrequency[t]++;
+    }
+    liveDocuments++;
+    liveTerms += doc.terms.size();
+    documents.push_back(std::move(doc));
+    documentOf[key] = number;
+
+    compactIfSparse();
+}
+
+void TextIndex::removeRecord(RecordSource source, int entityId, int recordId) {
+    if (!built) return;
+
+    auto it = documentOf.find(keyOf(source, entityId, recordId));
+    if (it == documentOf.end()) return;
+    retire(it->second);
+    documentOf.erase(it);
+    compactIfSparse();
+}
+
+void TextIndex::removeEntity(RecordSource source, int entityId) {
+    if (!built) return;
+
+    auto first = documentOf.lower_bound(keyOf(source, entityId, 0));
+    auto last = documentOf.upper_bound(keyOf(source, entityId, INT_MAX));
+    for (auto it = first; it != last; ++it) retire(it->second);
+    documentOf.erase(first, last);
+    compactIfSparse();
+}
+
+std::vector<uint32_t> TextIndex::matchClause(const std::vector<std::vector<uint32_t>>& items) const {
+    std::vector<uint32_t> terms;
+    for (const auto& item : items) terms.insert(terms.end(), item.begin(), item.end());
+    terms = sortedUnique(terms);
+    if (terms.empty() || terms.back() == UNKNOWN_TERM) return {};
+
+    // Walk the shortest posting list and probe the others, which are sorted
+    std::sort(terms.begin(), terms.end(),
+        [this](uint32_t a, uint32_t b) { return postings[a].size() < postings[b].size(); });
+    std::vector<size_t> cursor(terms.size(), 0);
+
+    std::vector<uint32_t> matches;
+    for (uint32_t doc : postings[terms[0]]) {
+        if (!documents[doc].live) continue;
+
+        bool inAll = true;
+        for (size_t k = 1; k < terms.size() && inAll; ++k) {
+            const auto& list = postings[terms[k]];
+            auto it = std::lower_bound(list.begin() + cursor[k], list.end(), doc);
+            cursor[k] = it - list.begin();
+            inAll = it != list.end() && *it == doc;
+        }
+        if (!inAll) continue;
+
+        const auto& text = documents[doc].terms;
+        bool phrasesFound = std::all_of(items.begin(), items.end(), [&text](const std::vector<uint32_t>& item) {
+            return item.size() < 2 || std::search(text.begin(), text.end(), item.begin(), item.end()) != text.end();
+        });
+        if (phrasesFound) matches.push_back(doc);
+    }
+    return matches;
+}
+
+double TextIndex::score(uint32_t doc, const std::vector<uint32_t>& queryTerms) const {
+    const auto& text = documents[doc].terms;
+    double averageLength = liveDocuments ? static_cast<double>(liveTerms) / liveDocuments : 1.0;
+    double lengthFactor = K1 * (1 - B + B * text.size() / std::max(averageLength, 1.0));
+
+    double total = 0;
+    for (uint32_t t : queryTerms) {
+        double tf = static_cast<double>(std::count(text.begin(), text.end(), t));
+        if (tf == 0) continue;
+        double df = liveFrequency[t];
+        double idf = std::log(1 + (liveDocuments - df + 0.5) / (df + 0.5));
+        total += idf * tf * (K1 + 1) / (tf + lengthFactor);
+    }
+    return total;
+}
+
+std::vector<TextHit> TextIndex::search(const std::string& query, size_t limit, bool includeMedicalHistory) const {
+    // Parse into OR-separated clauses of items; an item is one term or a phrase
+    std::vector<std::vector<std::vector<uint32_t>>> clauses(1);
+    std::vector<uint32_t> queryTerms;
+
+    auto addItem = [&](std::string_view text) {
+        std::vector<uint32_t> item;
+        for (const auto& token : tokenize(text)) {
+            auto it = termIds.find(token);
+            uint32_t t = it == termIds.end() ? UNKNOWN_TERM : it->second;
+            item.push_back(t);
+            if (t != UNKNOWN_TERM) queryTerms.push_back(t);
+        }
+        if (!item.empty()) clauses.back().push_back(std::move(item));
+    };
+
+    size_t pos = 0;
+    while (pos < query.size()) {
+        if (std::isspace(static_cast<unsigned char>(query[pos]))) {
+            pos++;
+        } else if (query[pos] == '"') {
+            size_t close = query.find('"', pos + 1);
+            if (close == std::string::npos) close = query.size();
+            addItem(std::string_view(query).substr(pos + 1, close - pos - 1));
+            pos = close + 1;
+        } else {
+            size_t end = pos;
+            while (end < query.size() && !std::isspace(static_cast<unsigned char>(query[end])) && query[end] != '"') end++;
+            std::string_view word = std::string_view(query).substr(pos, end - pos);
+            if (word == "OR") {
+                if (!clauses.back().empty()) clauses.emplace_back();
+            } else if (word != "AND") {
+                addItem(word);  // "x-ray" tokenizes to a two-word phrase
+            }
+            pos = end;
+        }
+    }
+    queryTerms = sortedUnique(queryTerms);
+
+    std::vector<uint32_t> matched;
+    for (const auto& clause : clauses) {
+        auto docs = matchClause(clause);
+        matched.insert(matched.end(), docs.begin(), docs.end());
+    }
+    matched = sortedUnique(matched);
+
+    std::vector<TextHit> hits;
+    hits.reserve(matched.size());
+    for (uint32_t doc : matched) {
+        const Document& d = documents[doc];
+        if (!includeMedicalHistory && d.source == RecordSource::MedicalHistory) continue;
+        hits.push_back(TextHit{ d.source, d.entityId, d.recordId, score(doc, queryTerms) });
+    }
+
+    size_t shown = std::min(limit, hits.size());
+    std::partial_sort(hits.begin(), hits.begin() + shown, hits.end(),
+        [](const TextHit& a, const TextHit& b) { return a.score > b.score; });
+    hits.resize(shown);
+    return hits;
+}
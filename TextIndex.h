@@ -0,0 +1,92 @@
+#ifndef TEXTINDEX_H
+#define TEXTINDEX_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+#include <map>
+#include <cstdint>
+#include <cstddef>
+
+class Pet;
+class Owner;
+
+// Which record map a search hit comes from
+enum class RecordSource : uint8_t {
+    MedicalHistory,   // Pet::getMedicalHistory()
+    PetRecord,        // Pet::getPetRecords()
+    OwnerRecord       // Owner::getRecords()
+};
+
+struct TextHit {
+    RecordSource source;
+    int entityId;     // pet ID or owner ID, depending on source
+    int recordId;
+    double score;
+};
+
+// Inverted index over the details text of pet medical history, pet records and
+// owner records.
+//
+// Each record is a document holding its token sequence; each term has a posting
+// list of document numbers in ascending order. Changing or removing a record
+// retires its document (the postings are cleaned up in bulk once retired
+// documents outnumber live ones) and a changed record is indexed again under a
+// new number, so posting lists only ever grow at the end.
+//
+// Queries: words are ANDed, "OR" separates alternatives and "double quotes"
+// mark a phrase, e.g.  ear infection OR "skin allergy"
+// Results are ranked with BM25.
+class TextIndex {
+    struct Document {
+        RecordSource source;
+        int entityId;
+        int recordId;
+        std::vector<uint32_t> terms;   // term IDs in text order, for phrases and term counts
+        bool live;
+    };
+
+    std::vector<Document> documents;
+    std::unordered_map<std::string, uint32_t> termIds;
+    std::vector<std::vector<uint32_t>> postings;       // term ID -> document numbers
+    std::vector<uint32_t> liveFrequency;               // term ID -> live documents containing it
+    std::map<uint64_t, uint32_t> documentOf;           // (source, entity, record) -> live document;
+                                                       // ordered so one entity's records are adjacent
+    size_t liveDocuments = 0;
+    size_t liveTerms = 0;                              // total tokens over live documents
+    bool built = false;
+
+    static uint64_t keyOf(RecordSource source, int entityId, int recordId);
+    uint32_t termId(const std::string& term);
+    void retire(uint32_t doc);
+    void compactIfSparse();   // drops retired documents once they outnumber live ones
+
+    // Live documents containing every term, then every phrase in order
+    std::vector<uint32_t> matchClause(const std::vector<std::vector<uint32_t>>& items) const;
+    double score(uint32_t doc, const std::vector<uint32_t>& queryTerms) const;
+
+public:
+    // Lower-cased runs of letters and digits (bytes >= 0x80 count as letters)
+    static std::vector<std::string> tokenize(std::string_view text);
+
+    // The index is built on first use, since it needs every record parsed
+    bool isBuilt() const { return built; }
+    void build(const std::vector<Pet>& pets, const std::vector<Owner>& owners);
+
+    // Adds or replaces one record's text. No-ops until the index is built.
+    void indexRecord(RecordSource source, int entityId, int recordId, const std::string& details);
+    void removeRecord(RecordSource source, int entityId, int recordId);
+
+    // Removes every record of one pet (or owner) from the given source
+    void removeEntity(RecordSource source, int entityId);
+
+    // Best `limit` matches for the query, highest score first; medical history
+    // is left out for users who may not see it
+    std::vector<TextHit> search(const std::string& query, size_t limit = 20, bool includeMedicalHistory = true) const;
+
+    size_t documentCount() const { return liveDocuments; }
+    size_t termCount() const { return termIds.size(); }
+};
+
+#endif  // TEXTINDEX_H
@@ -0,0 +1,208 @@
+#include "TrigramIndex.h"
+#include "TextIndex.h"
+#include "Pet.h"
+#include "Owner.h"
+#include <algorithm>
+
+// Candidates re-ranked by edit distance, per result asked for
+static const size_t CANDIDATES_PER_RESULT = 4;
+
+static std::string joinWords(const std::vector<std::string>& words) {
+    std::string text;
+    for (const auto& w : words) {
+        if (!text.empty()) text += ' ';
+        text += w;
+    }
+    return text;
+}
+
+std::vector<uint32_t> TrigramIndex::trigramsOf(std::string_view text) {
+    std::vector<uint32_t> grams;
+    for (const auto& word : TextIndex::tokenize(text)) {
+        std::string padded = "  " + word + " ";
+        for (size_t i = 0; i + 3 <= padded.size(); ++i) {
+            grams.push_back((static_cast<uint32_t>(static_cast<unsigned char>(padded[i])) << 16)
+                          | (static_cast<uint32_t>(static_cast<unsigned char>(padded[i + 1])) << 8)
+                          |  static_cast<uint32_t>(static_cast<unsigned char>(padded[i + 2])));
+        }
+    }
+    std::sort(grams.begin(), grams.end());
+    grams.erase(std::unique(grams.begin(), grams.end()), grams.end());
+    return grams;
+}
+
+size_t TrigramIndex::editDistance(std::string_view a, std::string_view b) {
+    // optimal string alignment distance, keeping the last three rows
+    std::vector<size_t> twoBack(b.size() + 1), previous(b.size() + 1), current(b.size() + 1);
+    for (size_t j = 0; j <= b.size(); ++j) previous[j] = j;
+
+    for (size_t i = 1; i <= a.size(); ++i) {
+        current[0] = i;
+        for (size_t j = 1; j <= b.size(); ++j) {
+            size_t cost = a[i - 1] == b[j - 1] ? 0 : 1;
+            current[j] = std::min({ previous[j] + 1, current[j - 1] + 1, previous[j - 1] + cost });
+            if (i > 1 && j > 1 && a[i - 1] == b[j - 2] && a[i - 2] == b[j - 1]) {
+                current[j] = std::min(current[j], twoBack[j - 2] + 1);
+            }
+        }
+        std::swap(twoBack, previous);
+        std::swap(previous, current);
+    }
+    return previous[b.size()];
+}
+
+void TrigramIndex::rebuild(const std::vector<Pet>& pets) {
+    entries.clear();
+    postings.clear();
+    entriesOf.clear();
+    liveEntries = 0;
+    for (const auto& p : pets) index(p);
+}
+
+void TrigramIndex::rebuild(const std::vector<Owner>& owners) {
+    entries.clear();
+    postings.clear();
+    entriesOf.clear();
+    liveEntries = 0;
+    for (const auto& o : owners) index(o);
+}
+
+void TrigramIndex::index(const Pet& pet) {
+    std::vector<std::string> names = { pet.getName(), pet.getBreed() };
+    for (const auto& v : pet.getVaccinations()) names.push_back(v.getName());
+    assign(pet.getPetId(), names);
+}
+
+void TrigramIndex::index(const Owner& owner) {
+    assign(owner.getOwnerId(), { owner.getName() });
+}
+
+void TrigramIndex::assign(int id, const std::vector<std::string>& names) {
+    remove(id);
+
+    // the whole name, plus each word of a longer name so "Smyth" finds "John Smith"
+    std::vector<std::string> texts;
+    for (const auto& name : names) {
+        std::vector<std::string> words = TextIndex::tokenize(name);
+        if (words.empty()) continue;
+        texts.push_back(joinWords(words));
+        if (words.size() > 1) texts.insert(texts.end(), words.begin(), words.end());
+    }
+    std::sort(texts.begin(), texts.end());
+    texts.erase(std::unique(texts.begin(), texts.end()), texts.end());
+
+    std::vector<uint32_t>& numbers = entriesOf[id];
+    for (auto& text : texts) {
+        uint32_t number = static_cast<uint32_t>(entries.size());
+        std::vector<uint32_t> grams = trigramsOf(text);
+        for (uint32_t g : grams) postings[g].push_back(number);
+        entries.push_back(Entry{ id, std::move(text), std::move(grams), true });
+        numbers.push_back(number);
+        liveEntries++;
+    }
+}
+
+void TrigramIndex::remove(int id) {
+    auto it = entriesOf.find(id);
+    if (it == entriesOf.end()) return;
+    for (uint32_t number : it->second) {
+        Entry& e = entries[number];
+        e.live = false;
+        e.text.clear();
+        e.text.shrink_to_fit();
+        e.grams.clear();
+        e.grams.shrink_to_fit();
+        liveEntries--;
+    }
+    entriesOf.erase(it);
+    compactIfSparse();
+}
+
+void TrigramIndex::compactIfSparse() {
+    size_t retired = entries.size() - liveEntries;
+    if (retired < 1024 || retired < liveEntries) return;
+
+    // renumbering keeps the relative order, so posting lists stay sorted
+    std::vector<uint32_t> renumbered(entries.size(), UINT32_MAX);
+    std::vector<Entry> kept;
+    kept.reserve(liveEntries);
+    for (size_t i = 0; i < entries.size(); ++i) {
+        if (!entries[i].live) continue;
+        renumbered[i] = static_cast<uint32_t>(kept.size());
+        kept.push_back(std::move(entries[i]));
+    }
+
+    for (auto it = postings.begin(); it != postings.end();) {
+        auto& list = it->second;
+        size_t out = 0;
+        for (uint32_t number : list) {
+            if (renumbered[number] != UINT32_MAX) list[out++] = renumbered[number];
+        }
+        list.resize(out);
+        it = list.empty() ? postings.erase(it) : std::next(it);
+    }
+    for (auto& [id, numbers] : entriesOf) {
+        for (uint32_t& number : numbers) number = renumbered[number];
+    }
+    entries = std::move(kept);
+}
+
+std::vector<FuzzyMatch> TrigramIndex::search(std::string_view query, size_t limit, double minJaccard) const {
+    std::vector<uint32_t> queryGrams = trigramsOf(query);
+    if (queryGrams.empty() || limit == 0) return {};
+
+    // count shared trigrams for every entry that has at least one; the scratch
+    // counts are zero on entry and only the touched ones are reset afterwards
+    std::vector<uint8_t>& shared = sharedCounts;
+    shared.resize(entries.size(), 0);
+    std::vector<uint32_t> touched;
+    for (uint32_t g : queryGrams) {
+        auto it = postings.find(g);
+        if (it == postings.end()) continue;
+        for (uint32_t number : it->second) {
+            if (shared[number] == 0) touched.push_back(number);
+            if (shared[number] < UINT8_MAX) shared[number]++;
+        }
+    }
+
+    struct Candidate {
+        uint32_t number;
+        double jaccard;
+        double similarity;
+    };
+    std::vector<Candidate> candidates;
+    for (uint32_t number : touched) {
+        const Entry& e = entries[number];
+        if (!e.live) continue;
+        double common = shared[number];
+        double jaccard = common / (queryGrams.size() + e.grams.size() - common);
+        if (jaccard >= minJaccard) candidates.push_back(Candidate{ number, jaccard, 0 });
+    }
+    for (uint32_t number : touched) shared[number] = 0;
+
+    // edit distance only for the best few by trigram similarity
+    size_t keep = std::min(candidates.size(), limit * CANDIDATES_PER_RESULT);
+    std::partial_sort(candidates.begin(), candidates.begin() + keep, candidates.end(),
+        [](const Candidate& a, const Candidate& b) { return a.jaccard > b.jaccard; });
+    candidates.resize(keep);
+
+    std::string wanted = joinWords(TextIndex::tokenize(query));
+    for (auto& c : candidates) {
+        const std::string& text = entries[c.number].text;
+        double longest = static_cast<double>(std::max(text.size(), wanted.size()));
+        c.similarity = 1.0 - editDistance(wanted, text) / longest;
+    }
+    std::sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b) {
+        return a.similarity != b.similarity ? a.similarity > b.similarity : a.jaccard > b.jaccard;
+    });
+
+    std::vector<FuzzyMatch> matches;
+    for (const auto& c : candidates) {
+        if (matches.size() == limit) break;
+        if (c.similarity <= 0) continue;
+        const Entry& e = entries[c.number];
+        bool seen = std::any_of(matches.begin(), matches.end(), [&e](const FuzzyMatch& m) { return m.id == e.id; });
+        if (!seen) matches.push_back(FuzzyMatch{ e.id, e.text, c.similarity });
+    }
+    return matches;
+}
@@ -0,0 +1,68 @@
+#ifndef TRIGRAMINDEX_H
+#define TRIGRAMINDEX_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include <cstddef>
+
+class Pet;
+class Owner;
+
+struct FuzzyMatch {
+    int id;                // pet ID or owner ID
+    std::string matched;   // the indexed name that matched, normalized
+    double similarity;     // 1 - edit distance / length, in (0, 1]
+};
+
+// Typo-tolerant name lookup.
+// Every indexed name (and each word of a multi-word name) is split into
+// trigrams of its lower-cased words, padded as "  w" ... "d ", so "Labrodor"
+// still shares most trigrams with "Labrador". A query counts shared trigrams
+// through the posting lists, keeps the best candidates by trigram Jaccard
+// similarity, and only those are re-ranked by edit distance.
+// Pets are indexed by name, breed and vaccination names; owners by name.
+class TrigramIndex {
+    struct Entry {
+        int id;
+        std::string text;              // normalized words joined by single spaces
+        std::vector<uint32_t> grams;   // distinct trigrams, sorted
+        bool live;
+    };
+
+    std::vector<Entry> entries;
+    std::unordered_map<uint32_t, std::vector<uint32_t>> postings;   // trigram -> entry numbers, ascending
+    std::unordered_map<int, std::vector<uint32_t>> entriesOf;       // ID -> its live entries
+    size_t liveEntries = 0;
+    mutable std::vector<uint8_t> sharedCounts;   // search() scratch per entry, all zero between queries
+
+    void assign(int id, const std::vector<std::string>& names);
+    void compactIfSparse();   // drops retired entries once they outnumber live ones
+
+public:
+    // Distinct padded trigrams of the text's words, sorted
+    static std::vector<uint32_t> trigramsOf(std::string_view text);
+
+    // Edit distance counting an adjacent transposition ("Jonh") as one edit
+    static size_t editDistance(std::string_view a, std::string_view b);
+
+    // Replaces the contents with every pet / every owner
+    void rebuild(const std::vector<Pet>& pets);
+    void rebuild(const std::vector<Owner>& owners);
+
+    // (Re-)indexes one pet's or owner's names; call after adding or changing them
+    void index(const Pet& pet);
+    void index(const Owner& owner);
+
+    // Forgets an ID; call when the pet or owner is deleted
+    void remove(int id);
+
+    // Closest names to the query, at most `limit` (one per ID), most similar first.
+    // Candidates need a trigram Jaccard similarity of at least minJaccard.
+    // Reuses a scratch buffer, so it must not run concurrently on one index.
+    std::vector<FuzzyMatch> search(std::string_view query, size_t limit = 10, double minJaccard = 0.2) const;
+};
+
+#endif  // TRIGRAMINDEX_H
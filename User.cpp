@@ -99,11 +99,13 @@ bool Staff::canManageOwnerRecords() const { return true; }
 
 
 // Load Users
-std::vector<std::unique_ptr<User>> User::loadFromFile(const std::string& filename) {
+std::vector<std::unique_ptr<User>> User::loadFromFile(const std::string& filename, int& nextUserId,
+                                                      UsernameIndex& usernames) {
     std::vector<std::unique_ptr<User>> users;
     std::ifstream file(filename);
     if (!file) {
         std::cerr << "Error! Cannot open file: " << filename << "\n";
+        usernames.rebuild(users);
         return users;
     }
 
@@ -119,6 +121,7 @@ std::vector<std::unique_ptr<User>> User::loadFromFile(const std::string& filenam
         std::getline(ss, role);
 
         int id = std::stoi(idStr);
+        if (id >= nextUserId) nextUserId = id + 1;
         std::string lowerRole = toLower(trim(role));
 
         try {
@@ -139,39 +142,19 @@ std::vector<std::unique_ptr<User>> User::loadFromFile(const std::string& filenam
     }
 
     // std::cout << "[loadFromFile] FINAL count: " << users.size() << "\n";
+    usernames.rebuild(users);
     return users;
 }
 
 
 
 // Authentication 
-User* User::authenticateUser(const std::vector<std::unique_ptr<User>>& users,
+User* User::authenticateUser(const UsernameIndex& usernames,
                              const std::string& enteredUsername,
                              const std::string& enteredPassword) {
-    std::string loweredEnteredUsername = enteredUsername;
-    // std::cout << "Raw password entered: [" << enteredPassword << "]\n";
-
-    std::transform(loweredEnteredUsername.begin(), loweredEnteredUsername.end(), loweredEnteredUsername.begin(), ::tolower);
-    // std::cout << "Raw password entered: [" << enteredPassword << "]\n";
-
-    std::string enteredHash = sha256(enteredPassword);
-
-    for (const auto& u : users) {
-        std::string storedUsername = u->getUsername();
-        std::transform(storedUsername.begin(), storedUsername.end(), storedUsername.begin(), ::tolower);
-        // std::cout << "AUTH Comparing with stored: " << u->getUsername() << " => " << u->getPassword() << "\n";
-
-        if (storedUsername == loweredEnteredUsername) {
-
-            // Temporary debug (optional)
-            // std::cout << "Comparing hashes:\n";
-            // std::cout << "Entered: " << enteredHash << "\n";
-            // std::cout << "Stored : " << u->getPassword() << "\n";
-
-            if (u->getPassword() == enteredHash) {
-                return u.get();
-            }
-        }
+    User* candidate = usernames.find(enteredUsername);
+    if (candidate && candidate->getPassword() == sha256(enteredPassword)) {
+        return candidate;
     }
     return nullptr;
 }
@@ -5,6 +5,8 @@
 #include <vector>
 #include <memory>
 
+class UsernameIndex;
+
 // Abstract base class representing a system user with role-based permissions.
 // Subclasses include Admin, Veterinarian, and Staff.
 class User {
@@ -43,10 +45,14 @@ public:
 
     // File I/O for saving user info
     virtual void saveToFile(std::ostream& out) const = 0;
-    static std::vector<std::unique_ptr<User>> loadFromFile(const std::string& filename);
-
-    // Authenticate
-    static User* authenticateUser(const std::vector<std::unique_ptr<User>>& users,
+    // Loads users from file, raising nextUserId past every loaded ID, and
+    // rebuilds `usernames` over them (the users stay put when the vector is moved)
+    static std::vector<std::unique_ptr<User>> loadFromFile(const std::string& filename, int& nextUserId,
+                                                           UsernameIndex& usernames);
+
+    // Authenticate: looks the username up in the index (case and surrounding
+    // spaces ignored) and checks the password's hash; returns the user or nullptr
+    static User* authenticateUser(const UsernameIndex& usernames,
                                   const std::string& username,
                                   const std::string& password);
 
@@ -0,0 +1,23 @@
+#include "UsernameIndex.h"
+#include "User.h"
+#include "validations.h"
+
+void UsernameIndex::rebuild(const std::vector<std::unique_ptr<User>>& users) {
+    userByName.clear();
+    userByName.reserve(users.size());
+    for (const auto& u : users) add(u.get());
+}
+
+void UsernameIndex::add(User* user) {
+    userByName.emplace(normalizeKey(user->getUsername()), user);
+}
+
+void UsernameIndex::remove(const User* user) {
+    auto it = userByName.find(normalizeKey(user->getUsername()));
+    if (it != userByName.end() && it->second == user) userByName.erase(it);
+}
+
+User* UsernameIndex::find(std::string_view username) const {
+    auto it = userByName.find(normalizeKey(username));
+    return it == userByName.end() ? nullptr : it->second;
+}
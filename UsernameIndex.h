@@ -0,0 +1,32 @@
+#ifndef USERNAMEINDEX_H
+#define USERNAMEINDEX_H
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <memory>
+
+class User;
+
+// Normalized username (trimmed, lower-case) -> user, for login and uniqueness checks.
+// Users are held by unique_ptr, so the pointers survive vector reallocation and
+// erases; a user object that is replaced (role change) must be removed and re-added.
+class UsernameIndex {
+    std::unordered_map<std::string, User*> userByName;
+
+public:
+    // Replaces the contents with every user in the vector
+    void rebuild(const std::vector<std::unique_ptr<User>>& users);
+
+    // Registers a user under their current username (an already-taken name keeps its first user)
+    void add(User* user);
+
+    // Unregisters a user; call before renaming, replacing or deleting them
+    void remove(const User* user);
+
+    // The user with this username (case and surrounding spaces ignored), or nullptr
+    User* find(std::string_view username) const;
+};
+
+#endif  // USERNAMEINDEX_H
@@ -3,6 +3,10 @@
 #include <string>
 #include <iostream>
 #include <iomanip>
+#include <cctype>
+#include <string_view>
+#include "Symbol.h"
+#include "DateTime.h"
 
 
 // Represents a vaccination record for a pet.
@@ -11,24 +15,42 @@
 class Vaccination {
 private:
     int id;                         // Unique vaccination ID
-    std::string name;               // Name of the vaccine
-    std::string date;               // Date of vaccination (e.g., "2025-04-08")
-    std::string status;             // Vaccination status (e.g., "completed", "pending")
+    Symbol name;                    // Name of the vaccine, interned
+    StoredDate date;                // Date of vaccination (or due date, if not given yet)
+    Symbol status;                  // Vaccination status (e.g., "completed", "pending"), interned, lower-case
 
+    // Statuses are stored lower-case, so a hand-edited "Pending" still counts as pending
+    static Symbol normalizedStatus(std::string_view s) {
+        std::string lower(s);
+        for (char& c : lower) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        return Symbol(lower);
+    }
 
 public:
     Vaccination(int id, const std::string& name, const std::string& date, const std::string& status)
-            : id(id), name(name), date(date), status(status) {}
+            : id(id), name(Symbol(name)), date(date), status(normalizedStatus(status)) {}
+
+    // Vaccination read from disk, with the date already packed
+    Vaccination(int id, std::string_view name, StoredDate date, std::string_view status)
+            : id(id), name(Symbol(name)), date(date), status(normalizedStatus(status)) {}
 
     // getters
     int getId() const { return id; }
-    std::string getName() const { return name; }
-    std::string getDate() const { return date; }
-    std::string getStatus() const { return status; }
+    const std::string& getName() const { return name.str(); }
+    std::string getDate() const { return date.toString(); }
+    Date getDateValue() const { return date.value(); }
+    const std::string& getStatus() const { return status.str(); }
+    Symbol getStatusSymbol() const { return status; }   // for comparing statuses as integers
+
+    // Not given yet: "pending" or "booster required"
+    bool isOutstanding() const {
+        static const Symbol pending("pending"), booster("booster required");
+        return status == pending || status == booster;
+    }
 
     // Setters (optional, if you want to allow updates)
-    void setDate(const std::string& newDate) { date = newDate; }
-    void setStatus(const std::string& newStatus) { status = newStatus; }
+    void setDate(const std::string& newDate) { date = StoredDate(newDate); }
+    void setStatus(const std::string& newStatus) { status = normalizedStatus(newStatus); }
 
     // Display in table row
     void displayAsTableRow() const {
@@ -40,7 +62,7 @@ public:
 
     // Serialization (optional, if needed)
     std::string serialize() const {
-        return name + "|" + date + "|" + status;
+        return name.str() + "|" + date.toString() + "|" + status.str();
     }
 
 
@@ -0,0 +1,47 @@
+#include "VaccinationQueue.h"
+#include "Pet.h"
+#include "Vaccination.h"
+
+void VaccinationQueue::rebuild(const std::vector<Pet>& pets) {
+    queue.clear();
+    entriesOf.clear();
+    for (const auto& p : pets) update(p);
+}
+
+void VaccinationQueue::update(const Pet& pet) {
+    remove(pet.getPetId());
+
+    std::vector<Entry> entries;
+    for (const auto& v : pet.getVaccinations()) {
+        if (v.isOutstanding()) entries.emplace_back(v.getDateValue(), pet.getPetId(), v.getId());
+    }
+    if (entries.empty()) return;
+
+    for (const auto& e : entries) queue.insert(e);
+    entriesOf[pet.getPetId()] = std::move(entries);
+}
+
+void VaccinationQueue::remove(int petId) {
+    auto it = entriesOf.find(petId);
+    if (it == entriesOf.end()) return;
+    for (const auto& e : it->second) queue.erase(e);
+    entriesOf.erase(it);
+}
+
+std::vector<DueVaccination> VaccinationQueue::dueBy(Date lastDate) const {
+    std::vector<DueVaccination> due;
+    auto it = queue.begin();
+    while (it != queue.end() && !std::get<0>(*it).valid()) ++it;   // skip the undated ones
+    for (; it != queue.end() && std::get<0>(*it) <= lastDate; ++it) {
+        due.push_back(DueVaccination{ std::get<0>(*it), std::get<1>(*it), std::get<2>(*it) });
+    }
+    return due;
+}
+
+std::vector<DueVaccination> VaccinationQueue::undated() const {
+    std::vector<DueVaccination> due;
+    for (auto it = queue.begin(); it != queue.end() && !std::get<0>(*it).valid(); ++it) {
+        due.push_back(DueVaccination{ std::get<0>(*it), std::get<1>(*it), std::get<2>(*it) });
+    }
+    return due;
+}
@@ -0,0 +1,51 @@
+#ifndef VACCINATIONQUEUE_H
+#define VACCINATIONQUEUE_H
+
+#include <string>
+#include <vector>
+#include <set>
+#include <tuple>
+#include <unordered_map>
+#include <cstddef>
+#include "DateTime.h"
+
+class Pet;
+class Vaccination;
+
+struct DueVaccination {
+    Date dueDate;
+    int petId;
+    int vaccinationId;
+};
+
+// Vaccinations still to be given ("pending" or "booster required"), ordered by
+// the date they are due. Asking for everything due by some date walks the set
+// from the front and touches only the entries it returns. Entries whose date
+// could not be read sort before every real date and are kept out of dueBy().
+class VaccinationQueue {
+    using Entry = std::tuple<Date, int, int>;   // (due date, pet ID, vaccination ID)
+
+    std::set<Entry> queue;
+    std::unordered_map<int, std::vector<Entry>> entriesOf;   // pet ID -> its entries in `queue`
+
+public:
+    // Replaces the contents with the outstanding vaccinations of every pet
+    void rebuild(const std::vector<Pet>& pets);
+
+    // Re-reads one pet's vaccinations; call after adding, updating or removing one
+    void update(const Pet& pet);
+
+    // Forgets a pet; call when it is deleted
+    void remove(int petId);
+
+    // Outstanding vaccinations due on or before lastDate (overdue ones included),
+    // earliest first
+    std::vector<DueVaccination> dueBy(Date lastDate) const;
+
+    // Outstanding vaccinations with an unreadable due date
+    std::vector<DueVaccination> undated() const;
+
+    size_t size() const { return queue.size(); }
+};
+
+#endif  // VACCINATIONQUEUE_H
@@ -2,8 +2,11 @@
 #include <iostream>
 #include "validations.h"
 #include "globals.h"
+#include "journal.h"
 #include "owner_menu_helpers.h"
 #include "Appointment.h"
+#include "SlotFinder.h"
+#include <iomanip>
 #include <vector>
 
 
@@ -36,12 +39,7 @@ void searchAppointmentsByOwnerId(const std::vector<Appointment>& appointments) {
         int ownerId = askForValidId("🔍 Enter Owner ID to search appointments (or press Enter/0 to return): ");
         if (ownerId == 0) break;
 
-        std::vector<Appointment> matches;
-        for (const auto& appt : appointments) {
-            if (appt.getOwnerId() == ownerId) {
-                matches.push_back(appt);
-            }
-        }
+        AppointmentView matches = appointmentIndex.forOwner(appointments, ownerId);
 
         if (matches.empty()) {
             std::cout << "❌ No appointments found for Owner ID " << ownerId << ".\n";
@@ -60,12 +58,7 @@ void searchAppointmentsByPetId(const std::vector<Appointment>& appointments) {
         int petId = askForValidId("🔍 Enter Pet ID to search appointments (or press Enter/0 to return): ");
         if (petId == 0) break;
 
-        std::vector<Appointment> matches;
-        for (const auto& appt : appointments) {
-            if (appt.getPetId() == petId) {
-                matches.push_back(appt);
-            }
-        }
+        AppointmentView matches = appointmentIndex.forPet(appointments, petId);
 
         if (matches.empty()) {
             std::cout << "❌ No appointments found for Pet ID " << petId << ".\n";
@@ -80,6 +73,135 @@ void searchAppointmentsByPetId(const std::vector<Appointment>& appointments) {
     }
 }
 
+void viewAppointmentCalendar(const std::vector<Appointment>& appointments) {
+    while (true) {
+        std::string from = askForValidDate("📅 Enter the first day (YYYY-MM-DD) (or press Enter/0 to return): ", true, true);
+        if (from.empty()) break;
+
+        std::string to = askForValidDate("📅 Enter the last day (YYYY-MM-DD) (or press Enter/0 to return): ", true, true);
+        if (to.empty()) break;
+
+        // the last day is shown in full, so the range ends at the following midnight
+        long long start = AppointmentIndex::minuteOf(from);
+        long long end = AppointmentIndex::minuteOf(to) + AppointmentIndex::MINUTES_PER_DAY;
+        if (end <= start) {
+            std::cout << "❌ The last day must not be before the first day.\n";
+            continue;
+        }
+
+        AppointmentView booked = appointmentIndex.between(appointments, start, end);
+        if (booked.empty()) {
+            std::cout << "📭 No appointments between " << from << " and " << to << ".\n";
+        } else {
+            std::cout << "\n🗓️ Appointments from " << from << " to " << to << ":\n";
+            Appointment::displayAppointmentsTable(booked);
+            promptToViewFullAppointment(booked);
+        }
+
+        if (!promptYesNo("🔁 View another period?")) break;
+    }
+}
+
+// Prints one "value  count" line per value of a status index, restricted to
+// the IDs in `only` when it is given
+static void printStatusCounts(const StatusIndex& index, const RoaringBitmap* only = nullptr) {
+    std::vector<std::string> values = index.values();
+    if (values.empty()) {
+        std::cout << "   (none)\n";
+        return;
+    }
+    for (const auto& value : values) {
+        uint64_t count = only ? index.with(value).andCardinality(*only) : index.count(value);
+        std::cout << "   " << std::left << std::setw(20) << value << count << "\n";
+    }
+}
+
+void viewStatusDashboard() {
+    std::cout << "\n📊 --- Status Dashboard ---\n";
+    std::cout << "📅 Appointments by status:\n";
+    printStatusCounts(appointmentIndex.statuses());
+    std::cout << "💉 Pets by overall vaccination status:\n";
+    printStatusCounts(petVaccinationStatus);
+    std::cout << "🧾 Pets with a vaccination in each status:\n";
+    printStatusCounts(vaccinationStatuses);
+
+    // date-range filters scan the columnar copy rather than the Appointment objects
+    static const Symbol scheduled("scheduled");
+    const AppointmentColumns& table = appointmentIndex.columns();
+    Date today = Date::today();
+    std::cout << "🗓️ Scheduled in the next 7 days: " << table.count(scheduled, today, today.plusDays(7))
+              << ", next 30 days: " << table.count(scheduled, today, today.plusDays(30)) << "\n";
+
+    std::vector<size_t> overdue = table.select(scheduled, Date(), today);
+    if (!overdue.empty()) {
+        const size_t shown = 10;
+        std::cout << "⏰ Still scheduled but dated in the past: " << overdue.size() << "\n";
+        std::cout << std::left << std::setw(6) << "ID" << std::setw(14) << "Date" << std::setw(8) << "Time"
+                  << std::setw(8) << "Pet" << "Purpose\n";
+        std::cout << std::string(56, '-') << "\n";
+        for (size_t i = 0; i < overdue.size() && i < shown; ++i) {
+            AppointmentColumns::Row row = table.row(overdue[i]);
+            std::cout << std::left << std::setw(6) << row.getAppointmentId() << std::setw(14) << row.getDate()
+                      << std::setw(8) << row.getTime() << std::setw(8) << row.getPetId() << row.getPurpose() << "\n";
+        }
+        if (overdue.size() > shown) std::cout << "... and " << overdue.size() - shown << " more\n";
+        std::cout << std::string(56, '-') << "\n";
+    }
+
+    while (true) {
+        int ownerId = askForValidId("\n👤 Enter an Owner ID to break the counts down (or press Enter/0 to return): ");
+        if (ownerId == 0) break;
+
+        Owner* owner = findOwnerById(owners, ownerId);
+        if (!owner) {
+            std::cout << "❌ Owner ID not found.\n";
+            continue;
+        }
+
+        // the owner's pets, and every appointment of those pets
+        RoaringBitmap ownedPets, petAppointments;
+        for (int petId : owner->getPetIds()) {
+            const Pet* pet = findPetById(pets, petId);
+            if (!pet) continue;
+            ownedPets.add(static_cast<uint32_t>(petId));
+            for (int appointmentId : pet->getAppointmentIds()) petAppointments.add(static_cast<uint32_t>(appointmentId));
+        }
+
+        std::cout << "\n📊 " << owner->getName() << " (🆔 " << ownerId << "): "
+                  << ownedPets.cardinality() << " pet(s), " << petAppointments.cardinality() << " appointment(s)\n";
+        std::cout << "📅 Their pets' appointments by status:\n";
+        printStatusCounts(appointmentIndex.statuses(), &petAppointments);
+        std::cout << "💉 Their pets by overall vaccination status:\n";
+        printStatusCounts(petVaccinationStatus, &ownedPets);
+
+        if (!promptYesNo("🔁 Break down another owner?")) break;
+    }
+}
+
+void findNextFreeSlots() {
+    while (true) {
+        std::string from = askForValidAppointmentDate("📅 Enter the earliest date (YYYY-MM-DD) (or press Enter/0 to return): ", false);
+        if (from.empty()) break;
+
+        int duration = askForMenuChoice(AppointmentIndex::SLOT_MINUTES, 240, "⏱️ Enter the duration in minutes (15-240): ");
+
+        std::vector<FreeSlot> slots = findFreeSlots(appointmentIndex, from, 10, duration);
+        if (slots.empty()) {
+            std::cout << "📭 No free time found in the next year.\n";
+        } else {
+            std::cout << "\n🕒 Next free start times for " << duration << " minutes (weekdays, 08:00-20:00):\n";
+            std::cout << std::left << std::setw(14) << "Date" << "Time\n";
+            std::cout << std::string(24, '-') << "\n";
+            for (const auto& slot : slots) {
+                std::cout << std::left << std::setw(14) << slot.date << slot.time << "\n";
+            }
+            std::cout << std::string(24, '-') << "\n";
+        }
+
+        if (!promptYesNo("🔁 Search again?")) break;
+    }
+}
+
 
 void addAppointment(std::vector<Appointment>& appointments, std::vector<Owner>& owners, std::vector<Pet>& pets, int& nextAppointmentId) {
     while (true) {
@@ -126,7 +248,7 @@ void addAppointment(std::vector<Appointment>& appointments, std::vector<Owner>&
             continue;
         }
 
-        std::string time = askForValidAppointmentTime("⏰ Enter appointment time (HH:MM) (or press Enter/0 to return): ");
+        std::string time = askForFreeAppointmentTime(date, "⏰ Enter appointment time (HH:MM) (or press Enter/0 to return): ");
         if (time.empty()) {
             std::cout << "❌ Appointment creation cancelled.\n";
             continue;
@@ -142,7 +264,8 @@ void addAppointment(std::vector<Appointment>& appointments, std::vector<Owner>&
         int appointmentId = nextAppointmentId++;
 
         appointments.emplace_back(appointmentId, ownerId, petId, date, time, purpose, status);
-        saveAllAppointmentsToFile(appointments);
+        appointmentIndex.add(appointments.back(), appointments.size() - 1);
+        journalAppointment(appointments.back());
 
         std::cout << "✅ Appointment (ID: " << appointmentId << ") created successfully.\n";
         if (!promptYesNo("➕ Add another appointment?")) break;
@@ -191,12 +314,24 @@ void updateAppointment(std::vector<Appointment>& appointments) {
             continue;
         }
 
+        // a booked appointment must not land on another one, whether it is
+        // moved or a cancelled one is booked again in its old slot
+        bool moved = !newDate.empty() || !newTime.empty();
+        bool wasCancelled = appt->getStatus() == "cancelled";
+        bool booked = (newStatus.empty() ? appt->getStatus() : newStatus) != "cancelled";
+        if (booked && (moved || wasCancelled) && reportAppointmentConflict(newDate.empty() ? appt->getDate() : newDate,
+                                                         newTime.empty() ? appt->getTime() : newTime, id)) {
+            std::cout << "❌ Update cancelled.\n";
+            continue;
+        }
+
         if (!newDate.empty()) appt->setDate(newDate);
         if (!newTime.empty()) appt->setTime(newTime);
         if (!newPurpose.empty()) appt->setPurpose(newPurpose);
         if (!newStatus.empty()) appt->setStatus(newStatus);
+        appointmentIndex.update(*appt);
 
-        saveAllAppointmentsToFile(appointments);
+        journalAppointment(*appt);
         std::cout << "✅ Appointment updated successfully.\n";
 
         if (!promptYesNo("✏️ Update another appointment?")) break;
@@ -210,22 +345,19 @@ void deleteAppointment(std::vector<Appointment>& appointments) {
         int id = askForValidId("🗑️ Enter Appointment ID to delete (or press Enter/0 to return): ");
         if (id == 0) break;
 
-        auto it = std::find_if(appointments.begin(), appointments.end(),
-            [id](const Appointment& a) {
-                return a.getAppointmentId() == id;
-            });
-
-        if (it == appointments.end()) {
+        Appointment* appt = findAppointmentById(appointments, id);
+        if (!appt) {
             std::cout << "❌ Appointment ID not found.\n";
             continue;
         }
 
         std::cout << "\n📋 Appointment Details:\n";
-        it->displayAppointmentDetails();
+        appt->displayAppointmentDetails();
 
         if (promptYesNo("⚠️ Are you sure you want to delete this appointment?")) {
-            appointments.erase(it);
-            saveAllAppointmentsToFile(appointments);
+            journalAppointmentRemoval(id);
+            appointmentIndex.remove(id);
+            appointments.erase(appointments.begin() + (appt - appointments.data()));
             std::cout << "✅ Appointment deleted successfully.\n";
 
             if (!promptYesNo("🗑️ Delete another appointment?")) break;
@@ -16,6 +16,15 @@ void searchAppointmentsByOwnerId(const std::vector<Appointment>& appointments);
 // Displays all appointments linked to a specific pet by pet ID.
 void searchAppointmentsByPetId(const std::vector<Appointment>& appointments);
 
+// Lists the appointments between two dates (both included) in time order.
+void viewAppointmentCalendar(const std::vector<Appointment>& appointments);
+
+// Suggests the next free appointment times from a chosen date onwards.
+void findNextFreeSlots();
+
+// Shows appointment and vaccination status counts, overall and for one owner's pets.
+void viewStatusDashboard();
+
 // Adds a new appointment, linking it to a pet and owner with validated input.
 void addAppointment(std::vector<Appointment>& appointments, std::vector<Owner>& owners, std::vector<Pet>& pets, int& nextAppointmentId);
 
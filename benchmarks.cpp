@@ -0,0 +1,362 @@
+// benchmarks.cpp
+// Micro-benchmarks for the in-memory lookup structures. Built with `make bench`,
+// separately from the main program; not part of vet_system itself.
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <algorithm>
+#include <regex>
+#include <map>
+#include <sstream>
+#include "globals.h"
+#include "validations.h"
+
+using Clock = std::chrono::steady_clock;
+
+// Fills the global pet list with `count` pets (IDs 1..count) and indexes it
+static void makePets(size_t count) {
+    pets.clear();
+    pets.reserve(count);
+    for (size_t i = 1; i <= count; ++i) {
+        pets.emplace_back(static_cast<int>(i), "Pet" + std::to_string(i), "Breed", 3, -1);
+    }
+    petIndex.rebuild(pets);
+}
+
+// Average nanoseconds per findPetById call over the given IDs. Searching the
+// global list goes through petIndex; any other vector is scanned linearly.
+static double timeLookups(const std::vector<Pet>& list, const std::vector<int>& ids) {
+    size_t found = 0;
+    auto start = Clock::now();
+    for (int id : ids) {
+        if (findPetById(list, id)) found++;
+    }
+    auto elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+
+    if (found != ids.size()) std::cerr << "⚠️ " << ids.size() - found << " lookups missed\n";
+    return elapsed / ids.size();
+}
+
+static void benchmarkPetLookup() {
+    std::cout << "🐾 findPetById latency (ns per lookup)\n";
+    std::cout << std::left << std::setw(12) << "pets" << std::setw(16) << "petIndex" << "linear scan\n";
+
+    std::mt19937 rng(42);
+    for (size_t count : { 10000u, 100000u, 1000000u }) {
+        makePets(count);
+        std::uniform_int_distribution<int> pick(1, static_cast<int>(count));
+
+        std::vector<int> ids(1000000);
+        for (int& id : ids) id = pick(rng);
+        double indexed = timeLookups(pets, ids);
+
+        // the scan is O(n) per lookup, so it gets fewer samples
+        ids.resize(std::max<size_t>(100, 20000000 / count));
+        const std::vector<Pet> copy = pets;
+        double scanned = timeLookups(copy, ids);
+
+        std::cout << std::left << std::setw(12) << count
+                  << std::setw(16) << std::fixed << std::setprecision(1) << indexed
+                  << scanned << "\n";
+    }
+}
+
+// Average microseconds per petNames.findPrefix call (top 20) for short prefixes
+static void benchmarkNamePrefix() {
+    std::cout << "\n🔤 petNames.findPrefix latency (µs per lookup, top 20)\n";
+    std::cout << std::left << std::setw(12) << "pets" << "prefix search\n";
+
+    std::mt19937 rng(7);
+    for (size_t count : { 10000u, 100000u, 1000000u }) {
+        makePets(count);
+        petNames.rebuild(pets);
+        std::uniform_int_distribution<int> pick(1, static_cast<int>(count));
+
+        std::vector<std::string> prefixes(100000);
+        for (auto& p : prefixes) p = "pet" + std::to_string(pick(rng)).substr(0, 2);
+
+        size_t matches = 0;
+        auto start = Clock::now();
+        for (const auto& p : prefixes) matches += petNames.findPrefix(p, 20).size();
+        auto elapsed = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+
+        if (matches == 0) std::cerr << "⚠️ no prefix matched\n";
+        std::cout << std::left << std::setw(12) << count
+                  << std::fixed << std::setprecision(2) << elapsed / prefixes.size() << "\n";
+    }
+}
+
+// Average microseconds per fuzzyPets.search call (top 10) for misspelled names.
+// Names are built from random syllables so trigram lists have realistic lengths.
+static void benchmarkFuzzySearch() {
+    std::cout << "\n🤔 fuzzyPets.search latency (µs per lookup, top 10)\n";
+    std::cout << std::left << std::setw(12) << "pets" << "fuzzy search\n";
+
+    static const char* syllables[] = { "ba", "ko", "ri", "tem", "lu", "shan", "mi", "dor", "ve", "nax",
+                                       "pel", "qui", "sa", "tor", "gu", "lin", "zo", "ra", "fen", "ol",
+                                       "ce", "wy", "hob", "ek", "jas", "mu", "pra", "sti", "yo", "dax",
+                                       "nel", "bri", "gar", "of", "thu", "vin", "ca", "lem", "ush", "qo" };
+    std::mt19937 rng(11);
+    std::uniform_int_distribution<int> syllable(0, 39), length(2, 4);
+    auto randomName = [&]() {
+        std::string name;
+        for (int n = length(rng); n > 0; --n) name += syllables[syllable(rng)];
+        return name;
+    };
+
+    for (size_t count : { 10000u, 100000u, 1000000u }) {
+        pets.clear();
+        pets.reserve(count);
+        for (size_t i = 1; i <= count; ++i) {
+            pets.emplace_back(static_cast<int>(i), randomName(), randomName(), 3, -1);
+        }
+        fuzzyPets.rebuild(pets);
+
+        // misspell existing names by swapping two adjacent letters
+        std::uniform_int_distribution<size_t> pick(0, count - 1);
+        std::vector<std::string> queries(1000);
+        for (auto& q : queries) {
+            q = pets[pick(rng)].getName();
+            size_t at = q.size() / 2;
+            std::swap(q[at - 1], q[at]);
+        }
+
+        size_t matches = 0;
+        auto start = Clock::now();
+        for (const auto& q : queries) matches += fuzzyPets.search(q, 10).size();
+        auto elapsed = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+
+        if (matches == 0) std::cerr << "⚠️ no fuzzy match found\n";
+        std::cout << std::left << std::setw(12) << count
+                  << std::fixed << std::setprecision(2) << elapsed / queries.size() << "\n";
+    }
+}
+
+static void benchmarkStatusCounts() {
+    std::cout << "\n📊 \"scheduled AND in a 2% sample\" count (ms per query)\n";
+    std::cout << std::left << std::setw(14) << "appointments" << std::setw(16) << "string scan" << "bitmap AND\n";
+
+    static const std::string statuses[] = { "scheduled", "completed", "cancelled" };
+    std::mt19937 rng(13);
+    std::discrete_distribution<int> status({ 50, 35, 15 });
+    std::uniform_int_distribution<int> percent(0, 99);
+
+    for (size_t count : { 100000u, 1000000u, 4000000u }) {
+        StatusIndex index;
+        std::vector<std::string> statusOf(count + 1);
+        std::vector<char> inSample(count + 1, 0);
+        RoaringBitmap sample;
+        for (size_t id = 1; id <= count; ++id) {
+            statusOf[id] = statuses[status(rng)];
+            index.assign(static_cast<int>(id), { statusOf[id] });
+            if (percent(rng) < 2) {
+                inSample[id] = 1;
+                sample.add(static_cast<uint32_t>(id));
+            }
+        }
+
+        const int rounds = 20;
+        uint64_t scanned = 0, counted = 0;
+        auto start = Clock::now();
+        for (int r = 0; r < rounds; ++r) {
+            for (size_t id = 1; id <= count; ++id) {
+                if (inSample[id] && statusOf[id] == "scheduled") scanned++;
+            }
+        }
+        auto scanTime = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+        start = Clock::now();
+        for (int r = 0; r < rounds; ++r) counted += index.with("scheduled").andCardinality(sample);
+        auto bitmapTime = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+        if (scanned != counted) std::cerr << "⚠️ bitmap count " << counted << " differs from scan " << scanned << "\n";
+        std::cout << std::left << std::setw(14) << count << std::fixed << std::setprecision(3)
+                  << std::setw(16) << scanTime / rounds << bitmapTime / rounds << "\n";
+    }
+}
+
+static void benchmarkInternedStatus() {
+    std::cout << "\n🏷️ Counting cancelled appointments (ms per pass)\n";
+    std::cout << "   sizeof(Appointment) = " << sizeof(Appointment) << " bytes, sizeof(Vaccination) = "
+              << sizeof(Vaccination) << " bytes, sizeof(Record) = " << sizeof(Record) << " bytes\n";
+    std::cout << std::left << std::setw(14) << "appointments" << std::setw(16) << "string ==" << "symbol ==\n";
+
+    static const std::string statuses[] = { "scheduled", "completed", "cancelled" };
+    static const Symbol cancelled("cancelled");
+    std::mt19937 rng(17);
+    std::uniform_int_distribution<int> status(0, 2);
+
+    for (size_t count : { 100000u, 1000000u }) {
+        std::vector<Appointment> list;
+        list.reserve(count);
+        for (size_t i = 1; i <= count; ++i) {
+            list.emplace_back(static_cast<int>(i), 1, 1, "2026-01-05", "10:00", "Check-up", statuses[status(rng)]);
+        }
+
+        const int rounds = 20;
+        size_t byString = 0, bySymbol = 0;
+        auto start = Clock::now();
+        for (int r = 0; r < rounds; ++r) {
+            for (const auto& a : list) byString += a.getStatus() == "cancelled";
+        }
+        auto stringTime = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+        start = Clock::now();
+        for (int r = 0; r < rounds; ++r) {
+            for (const auto& a : list) bySymbol += a.getStatusSymbol() == cancelled;
+        }
+        auto symbolTime = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+        if (byString != bySymbol) std::cerr << "⚠️ symbol count differs from string count\n";
+        std::cout << std::left << std::setw(14) << count << std::fixed << std::setprecision(3)
+                  << std::setw(16) << stringTime / rounds << symbolTime / rounds << "\n";
+    }
+}
+
+static void benchmarkDateParsing() {
+    std::cout << "\n📆 Parsing YYYY-MM-DD (ns per date)\n";
+    std::cout << std::left << std::setw(20) << "regex + stoi" << "Date::parse\n";
+
+    std::mt19937 rng(19);
+    std::uniform_int_distribution<int> day(0, 20000);
+    std::vector<std::string> texts(200000);
+    for (auto& t : texts) t = Date::fromDays(day(rng)).toString();
+
+    const std::regex pattern(R"(^\d{4}-\d{2}-\d{2}$)");
+    long long checksum = 0;
+    auto start = Clock::now();
+    for (const auto& t : texts) {
+        if (!std::regex_match(t, pattern)) continue;
+        checksum += std::stoi(t.substr(0, 4)) * 372 + std::stoi(t.substr(5, 2)) * 31 + std::stoi(t.substr(8, 2));
+    }
+    auto regexTime = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+
+    long long packed = 0;
+    start = Clock::now();
+    for (const auto& t : texts) packed += Date::parse(t).daysSinceEpoch();
+    auto parseTime = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+
+    if (checksum == 0 || packed == 0) std::cerr << "⚠️ nothing parsed\n";
+    std::cout << std::left << std::fixed << std::setprecision(1)
+              << std::setw(20) << regexTime / texts.size() << parseTime / texts.size() << "\n";
+}
+
+static void benchmarkColumnarFilter() {
+    std::cout << "\n🧮 \"scheduled AND dated in a 30-day window\" count (ms per query)\n";
+    std::cout << std::left << std::setw(14) << "appointments" << std::setw(20) << "Appointment loop" << "columns\n";
+
+    static const std::string statuses[] = { "scheduled", "completed", "cancelled" };
+    static const Symbol scheduled("scheduled");
+    std::mt19937 rng(23);
+    std::uniform_int_distribution<int> status(0, 2);
+    std::uniform_int_distribution<int> day(0, 730);
+    const Date first = Date::fromCivil(2025, 1, 1);
+    const Date from = first.plusDays(300), to = from.plusDays(30);
+
+    for (size_t count : { 100000u, 1000000u }) {
+        std::vector<Appointment> list;
+        list.reserve(count);
+        for (size_t i = 1; i <= count; ++i) {
+            list.emplace_back(static_cast<int>(i), 1, 1, first.plusDays(day(rng)).toString(), "10:00", "Check-up",
+                              statuses[status(rng)]);
+        }
+        AppointmentColumns table;
+        table.rebuild(list);
+
+        const int rounds = 20;
+        size_t byObject = 0, byColumn = 0;
+        auto start = Clock::now();
+        for (int r = 0; r < rounds; ++r) {
+            for (const auto& a : list) {
+                Date date = a.getDateValue();
+                byObject += a.getStatusSymbol() == scheduled && date >= from && date < to;
+            }
+        }
+        auto objectTime = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+        start = Clock::now();
+        for (int r = 0; r < rounds; ++r) byColumn += table.count(scheduled, from, to);
+        auto columnTime = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+        if (byObject != byColumn || table.select(scheduled, from, to).size() * rounds != byColumn) {
+            std::cerr << "⚠️ column count differs from object count\n";
+        }
+        std::cout << std::left << std::setw(14) << count << std::fixed << std::setprecision(3)
+                  << std::setw(20) << objectTime / rounds << columnTime / rounds << "\n";
+    }
+}
+
+// Fills `maps` from `source` (perMap records each, IDs ascending as when loading),
+// then walks and probes them; returns ns per record for load, iterate and lookup
+template <typename Map>
+static void timeRecordMaps(const std::vector<Record>& source, size_t perMap, double (&nsPerRecord)[3]) {
+    std::vector<Map> maps(source.size() / perMap);
+    auto start = Clock::now();
+    for (size_t m = 0; m < maps.size(); ++m) {
+        for (size_t i = 0; i < perMap; ++i) maps[m].insert_or_assign(static_cast<int>(i + 1), source[m * perMap + i]);
+    }
+    nsPerRecord[0] = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / source.size();
+
+    size_t bytes = 0;
+    start = Clock::now();
+    for (const auto& map : maps) {
+        for (const auto& [id, record] : map) bytes += record.getDetailsView().size() + static_cast<size_t>(id);
+    }
+    nsPerRecord[1] = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / source.size();
+
+    std::mt19937 rng(31);
+    std::uniform_int_distribution<int> id(1, static_cast<int>(perMap));
+    std::vector<int> probes(source.size());
+    for (auto& probe : probes) probe = id(rng);
+    size_t found = 0;
+    start = Clock::now();
+    for (size_t m = 0; m < maps.size(); ++m) {
+        for (size_t i = 0; i < perMap; ++i) found += maps[m].find(probes[m * perMap + i]) != maps[m].end();
+    }
+    nsPerRecord[2] = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / source.size();
+
+    if (bytes == 0 || found != source.size()) std::cerr << "⚠️ record map walk or lookup came up short\n";
+}
+
+static void benchmarkRecordMaps() {
+    std::cout << "\n🗂️ Record maps, 1M records split into maps of N (ns per record: std::map / RecordMap)\n";
+    std::cout << std::left << std::setw(8) << "N" << std::setw(20) << "load" << std::setw(20) << "iterate" << "lookup\n";
+
+    const size_t total = 1 << 20;
+    std::vector<Record> source;
+    source.reserve(total);
+    TextArena text;   // the records' details, kept apart from the loaded data
+    const StoredDate date("2026-01-05");
+    for (size_t i = 0; i < total; ++i) {
+        std::string details = "Routine check " + std::to_string(i) + ", weight and teeth fine";
+        source.emplace_back(date, ArenaString::inArena(text.store(details)), "Pet");
+    }
+
+    for (size_t perMap : { 8u, 64u, 1024u }) {
+        double tree[3], flat[3];
+        timeRecordMaps<std::map<int, Record>>(source, perMap, tree);
+        timeRecordMaps<RecordMap>(source, perMap, flat);
+
+        std::cout << std::left << std::setw(8) << perMap;
+        for (int k = 0; k < 3; ++k) {
+            std::ostringstream cell;
+            cell << std::fixed << std::setprecision(1) << tree[k] << " / " << flat[k];
+            std::cout << std::setw(k < 2 ? 20 : 0) << cell.str();
+        }
+        std::cout << "\n";
+    }
+}
+
+int main() {
+    benchmarkPetLookup();
+    benchmarkNamePrefix();
+    benchmarkFuzzySearch();
+    benchmarkStatusCounts();
+    benchmarkInternedStatus();
+    benchmarkDateParsing();
+    benchmarkColumnarFilter();
+    benchmarkRecordMaps();
+    return 0;
+}
@@ -2,16 +2,37 @@
 #include "globals.h"
 #include "Owner.h"
 #include <fstream>
+#include <sstream>
+#include "persistence.h"
 #include "Pet.h"
 #include "Appointment.h"
 #include "validations.h"
 
+SymbolTable symbols;
+TextArena loadedText;   // before the pets and owners whose records point into it
+
 std::vector<Pet> pets;
 std::vector<Owner> owners;
 std::vector<Appointment> appointments;
 // std::vector<User> users;
 std::vector<std::unique_ptr<User>> users;
 
+PetIndex petIndex;
+OwnerIndex ownerIndex;
+AppointmentIndex appointmentIndex;
+OwnerContactIndex ownerContacts;
+UsernameIndex usernameIndex;
+TextIndex textIndex;
+NameIndex petNames;
+NameIndex ownerNames;
+TrigramIndex fuzzyPets;
+TrigramIndex fuzzyOwners;
+VaccinationQueue vaccinationQueue;
+std::set<int> unassignedPetIds;
+StatusIndex petVaccinationStatus;
+StatusIndex vaccinationStatuses;
+PetSaveStats petSaveStats;
+
 
 int nextPetId = 1;
 int nextOwnerId = 1;
@@ -24,35 +45,37 @@ std::string truncateDetails(const std::string& details, size_t maxLength) {
     return details.substr(0, maxLength - 3) + "...";
 }
 
-void saveAllOwnersToFile(const std::vector<Owner>& owners, const std::string& filename) {
-    std::ofstream file(filename);
-    if (!file) {
-        std::cerr << "Error opening " << filename << " for writing.\n";
-        return;
-    }
+void saveAllOwnersToFile(const std::vector<Owner>& owners, const std::string& filename, std::function<void()> onWritten) {
+    std::ostringstream file;
     // Write header
     file << "owner_id,name,address,phone_number,email,pet_ids,records\n";
     // Write each owner
     for (const auto& o : owners) {
         o.writeToFileStream(file);
     }
-    file.close();
+    requestSave(filename, file.str(), std::move(onWritten));
 }
 
-void saveAllPetsToFile(const std::vector<Pet>& pets, const std::string& filename) {
-    std::ofstream file(filename);
-    if (!file) {
-        std::cerr << "Error opening " << filename << " for writing.\n";
-        return;
-    }
+void saveAllPetsToFile(const std::vector<Pet>& pets, const std::string& filename, std::function<void()> onWritten) {
+    std::string file;
     // headers
-    file << "pet_id,name,breed,age,owner_id,vaccination_status,vaccinations,medical_history,pet_records\n";
-    // fill each pet
+    file += "pet_id,name,breed,age,owner_id,vaccination_status,vaccinations,medical_history,pet_records\n";
+    // fill each pet, re-encoding only the ones that changed since their last save
+    petSaveStats.saves++;
     for (const auto& p : pets) {
-        p.writeToFileStream(file);
+        bool dirty = p.isRowDirty();
+        std::string_view row = p.csvRow();
+        if (dirty) {
+            petSaveStats.reencodedRows++;
+            petSaveStats.reencodedBytes += row.size() + 1;
+        } else {
+            petSaveStats.reusedRows++;
+            petSaveStats.reusedBytes += row.size() + 1;
+        }
+        file += row;
+        file += '\n';
     }
-    std::cout << "\n";
-    file.close();
+    requestSave(filename, std::move(file), std::move(onWritten));
 }
 
 std::string escapeCommas(const std::string& input) {
@@ -65,17 +88,21 @@ std::string escapeCommas(const std::string& input) {
     return output;
 }
 
-std::string unescapeCommas(const std::string& input) {
-    std::string output = input;
+std::string unescapeCommas(std::string_view input) {
+    std::string output;
+    output.reserve(input.size());
     size_t pos = 0;
-    while ((pos = output.find("[comma]", pos)) != std::string::npos) {
-        output.replace(pos, 7, ",");
-        pos += 1;
+    size_t found;
+    while ((found = input.find("[comma]", pos)) != std::string_view::npos) {
+        output.append(input, pos, found - pos);
+        output += ',';
+        pos = found + 7; // move past the replaced part
     }
+    output.append(input, pos, std::string_view::npos);
     return output;
 }
 
-bool displayFullRecordIfExists(const std::map<int, Record>& records, int recordId, const std::string& recordType) {
+bool displayFullRecordIfExists(const RecordMap& records, int recordId, const std::string& recordType) {
     auto it = records.find(recordId);
     if (it != records.end()) {
         displayFullRecord(records, recordId, recordType);
@@ -84,7 +111,7 @@ bool displayFullRecordIfExists(const std::map<int, Record>& records, int recordI
     return false;
 }
 
-void displayFullRecord(const std::map<int, Record>& records, int recordId, const std::string& recordType) {
+void displayFullRecord(const RecordMap& records, int recordId, const std::string& recordType) {
     auto it = records.find(recordId);
     if (it != records.end()) {
         std::cout << "\n📄 ----- " << recordType << " Details -----\n";
@@ -100,41 +127,44 @@ void displayFullRecord(const std::map<int, Record>& records, int recordId, const
 
 
 // appointments
-void saveAllAppointmentsToFile(const std::vector<Appointment>& appointments) {
-    std::ofstream file("appointments.csv");
-    if (!file) {
-        std::cerr << "Error opening appointments.csv for writing.\n";
-        return;
-    }
-
+void saveAllAppointmentsToFile(const std::vector<Appointment>& appointments, std::function<void()> onWritten) {
+    std::ostringstream file;
     file << "appointment_id,owner_id,pet_id,date,time,purpose,status\n";
     for (const auto& appt : appointments) {
-        file << appt.getAppointmentId() << ","
-             << appt.getOwnerId() << ","
-             << appt.getPetId() << ","
-             << appt.getDate() << ","
-             << appt.getTime() << ","
-             << escapeCommas(appt.getPurpose()) << ","
-             << appt.getStatus() << "\n";
+        appt.writeToFileStream(file);
     }
-    file.close();
+    requestSave("appointments.csv", file.str(), std::move(onWritten));
 }
 
 std::vector<Appointment> loadAllAppointmentsFromFile(const std::string& filename) {
-    return Appointment::loadFromFile(filename);
+    return Appointment::loadFromFile(filename, nextAppointmentId);
 }
 
 
-std::vector<Appointment> getAppointmentsForPet(int petId) {
-    std::vector<Appointment> result;
-    for (const auto& appt : appointments) {
-        if (appt.getPetId() == petId) {
-            result.push_back(appt);
-        }
-    }
-    return result;
+AppointmentView getAppointmentsForPet(int petId) {
+    return appointmentIndex.forPet(appointments, petId);
+}
+
+
+void indexVaccinationStatuses(const Pet& pet) {
+    std::vector<std::string> statuses;
+    for (const auto& v : pet.getVaccinations()) statuses.push_back(v.getStatus());
+    petVaccinationStatus.assign(pet.getPetId(), { pet.calculateVaccinationStatus() });
+    vaccinationStatuses.assign(pet.getPetId(), statuses);
 }
 
+void rebuildVaccinationStatuses(const std::vector<Pet>& pets) {
+    petVaccinationStatus.clear();
+    vaccinationStatuses.clear();
+    for (const auto& pet : pets) indexVaccinationStatuses(pet);
+}
+
+void rebuildUnassignedPets(const std::vector<Pet>& pets) {
+    unassignedPetIds.clear();
+    for (const auto& pet : pets) {
+        if (pet.getOnwerId() == -1) unassignedPetIds.insert(pet.getPetId());
+    }
+}
 
 void displayUnassignedPets(const std::vector<Pet>& pets) {
     bool found = false;
@@ -144,13 +174,14 @@ void displayUnassignedPets(const std::vector<Pet>& pets) {
               << std::setw(22) << "Breed" 
               << std::setw(6)  << "Age" << "\n";
     std::cout << std::string(50, '-') << "\n";
-    for (const auto& pet : pets) {
-        if (pet.getOnwerId() == -1) {
+    for (int id : unassignedPetIds) {
+        const Pet* pet = findPetById(pets, id);
+        if (pet && pet->getOnwerId() == -1) {
             found = true;
-            std::cout << std::setw(6)  << pet.getPetId() 
-                      << std::setw(20) << pet.getName() 
-                      << std::setw(20) << pet.getBreed() 
-                      << std::setw(6)  << pet.getAge() << "\n";
+            std::cout << std::setw(6)  << pet->getPetId() 
+                      << std::setw(20) << pet->getName() 
+                      << std::setw(20) << pet->getBreed() 
+                      << std::setw(6)  << pet->getAge() << "\n";
         }
     }
     if (!found) {
@@ -161,7 +192,7 @@ void displayUnassignedPets(const std::vector<Pet>& pets) {
 }
 
 
-void promptToViewFullAppointment(const std::vector<Appointment>& appointments) {
+void promptToViewFullAppointment(const AppointmentView& appointments) {
     if (appointments.empty()) return;
 
     if (promptYesNo("🔍 View full details of any appointment?")) {
@@ -169,12 +200,12 @@ void promptToViewFullAppointment(const std::vector<Appointment>& appointments) {
             int apptId = askForValidId("🔢 Enter Appointment ID to view (or press Enter/0 to return): ");
             if (apptId == 0) break;
 
-            auto it = std::find_if(appointments.begin(), appointments.end(), [apptId](const Appointment& appt) {
-                return appt.getAppointmentId() == apptId;
+            auto it = std::find_if(appointments.begin(), appointments.end(), [apptId](const Appointment* appt) {
+                return appt->getAppointmentId() == apptId;
             });
 
             if (it != appointments.end()) {
-                it->displayAppointmentDetails();
+                (*it)->displayAppointmentDetails();
                 break;
             } else {
                 std::cout << "❌ Appointment ID not found in this list. Please try again.\n";
@@ -182,3 +213,32 @@ void promptToViewFullAppointment(const std::vector<Appointment>& appointments) {
         }
     }
 }
+
+void reportPetSaveStats() {
+    if (petSaveStats.saves == 0) return;
+    std::cout << "💾 pets.csv: " << petSaveStats.saves << " save(s), re-encoded " << petSaveStats.reencodedRows
+              << " row(s) (" << petSaveStats.reencodedBytes << " bytes), reused " << petSaveStats.reusedRows
+              << " (" << petSaveStats.reusedBytes << " bytes).\n";
+    petSaveStats = PetSaveStats();
+}
+
+void printDataStats() {
+    // pet records are parsed on first use; parse them all so the arena figures are complete
+    size_t medicalRecords = 0, petRecords = 0, ownerRecords = 0;
+    for (const auto& pet : pets) {
+        medicalRecords += pet.getMedicalHistory().size();
+        petRecords += pet.getPetRecords().size();
+    }
+    for (const auto& owner : owners) ownerRecords += owner.getRecords().size();
+
+    std::cout << "📊 Loaded data\n";
+    std::cout << "🐾 Pets        : " << pets.size() << " (" << medicalRecords << " medical, "
+              << petRecords << " general records)\n";
+    std::cout << "👤 Owners      : " << owners.size() << " (" << ownerRecords << " records)\n";
+    std::cout << "📅 Appointments: " << appointments.size() << "\n";
+    std::cout << "🔐 Users       : " << users.size() << "\n";
+    std::cout << "🧵 Record text : " << loadedText.bytesUsed() << " bytes in " << loadedText.textCount()
+              << " texts; " << loadedText.bytesReserved() << " bytes reserved in "
+              << loadedText.blockCount() << " block(s)\n";
+    std::cout << "🏷️ Interned    : " << symbols.size() << " distinct strings, " << symbols.textBytes() << " bytes\n";
+}
@@ -3,12 +3,32 @@
 #define GLOBALS_H
 
 #include <vector>
+#include <string_view>
 #include <memory>
+#include <functional>
 #include <map>
+#include <set>
+#include "Symbol.h"
+#include "TextArena.h"
 #include "Pet.h"
 #include "Owner.h"
 #include "Appointment.h"
 #include "User.h"
+#include "PetIndex.h"
+#include "OwnerIndex.h"
+#include "OwnerContactIndex.h"
+#include "UsernameIndex.h"
+#include "TextIndex.h"
+#include "NameIndex.h"
+#include "TrigramIndex.h"
+#include "VaccinationQueue.h"
+#include "StatusIndex.h"
+
+// Interned texts of breeds, vaccine names, statuses and record types (see Symbol)
+extern SymbolTable symbols;
+
+// Details of records read from disk (see Record); freed in one go at exit
+extern TextArena loadedText;
 
 // Global vectors storing system-wide data
 extern std::vector<Pet> pets;                        // List of all pets
@@ -16,46 +36,111 @@ extern std::vector<Owner> owners;                    // List of all owners
 extern std::vector<Appointment> appointments;        // List of all appointments
 extern std::vector<std::unique_ptr<User>> users;     // List of all system users (with roles)
 
+// petId -> position in `pets`; rebuilt after loads and deletions, extended on add
+extern PetIndex petIndex;
+
+// ownerId -> position in `owners`; rebuilt after loads and deletions, extended on add
+extern OwnerIndex ownerIndex;
+
+// ownerId / petId / date -> appointments; kept in step with `appointments`
+extern AppointmentIndex appointmentIndex;
+
+// normalized owner phone / email -> ownerId, for uniqueness checks
+extern OwnerContactIndex ownerContacts;
+
+// normalized username -> user, for login and username uniqueness
+extern UsernameIndex usernameIndex;
+
+// Full-text search over medical history, pet records and owner records;
+// built on the first search, then kept current by the record mutators
+extern TextIndex textIndex;
+
+// Name prefix search: pet name/breed -> petId, owner name -> ownerId
+extern NameIndex petNames;
+extern NameIndex ownerNames;
+
+// Typo-tolerant name search: pets by name/breed/vaccination, owners by name
+extern TrigramIndex fuzzyPets;
+extern TrigramIndex fuzzyOwners;
+
+// Pending / booster-required vaccinations ordered by due date
+extern VaccinationQueue vaccinationQueue;
+
+// Pet IDs by overall vaccination status (Pet::calculateVaccinationStatus), and
+// by the status of each of their vaccinations; see indexVaccinationStatuses
+extern StatusIndex petVaccinationStatus;
+extern StatusIndex vaccinationStatuses;
+
+// IDs of pets with no owner (owner ID -1); kept current wherever a pet is
+// added, deleted or has its owner changed
+extern std::set<int> unassignedPetIds;
+
 // Global counters for assigning unique IDs
 extern int nextPetId;
 extern int nextOwnerId;
 extern int nextAppointmentId;
 extern int nextUserId;
 
-// Saves all owner records to a CSV file (default: "owners.csv")
-void saveAllOwnersToFile(const std::vector<Owner>& owners, const std::string& filename = "owners.csv");
+// Serializes all owner records and queues them for the background writer (default: "owners.csv").
+// onWritten, if given, runs once the file has been safely replaced.
+void saveAllOwnersToFile(const std::vector<Owner>& owners, const std::string& filename = "owners.csv",
+                         std::function<void()> onWritten = nullptr);
+
+// Serializes all pet records and queues them for the background writer (default: "pets.csv")
+void saveAllPetsToFile(const std::vector<Pet>& pets, const std::string& filename = "pets.csv",
+                       std::function<void()> onWritten = nullptr);
 
-// Saves all pet records to a CSV file (default: "pets.csv")
-void saveAllPetsToFile(const std::vector<Pet>& pets, const std::string& filename = "pets.csv");
+// Pet rows re-encoded vs. reused (from the cached row) by saveAllPetsToFile
+struct PetSaveStats {
+    size_t saves = 0;
+    size_t reencodedRows = 0, reencodedBytes = 0;
+    size_t reusedRows = 0, reusedBytes = 0;
+};
+extern PetSaveStats petSaveStats;
+
+// Prints petSaveStats as one line (if any pet save happened) and resets them;
+// called once per session at logout
+void reportPetSaveStats();
 
 // Escapes commas in a string for safe CSV storage
 std::string escapeCommas(const std::string& input);
 
 // Reverses escaped commas in a string to restore original content
-std::string unescapeCommas(const std::string& input);
+std::string unescapeCommas(std::string_view input);
 
 // Truncates long strings for cleaner display (default limit: 40 characters)
 std::string truncateDetails(const std::string& details, size_t maxLength = 40);
 
 // Displays full details of a single record by ID
-void displayFullRecord(const std::map<int, Record>& records, int recordId, const std::string& recordType = "Record");
+void displayFullRecord(const RecordMap& records, int recordId, const std::string& recordType = "Record");
 
-// Saves all appointment records to file (appointments.csv)
-void saveAllAppointmentsToFile(const std::vector<Appointment>& appointments);
+// Serializes all appointment records and queues them for the background writer (appointments.csv)
+void saveAllAppointmentsToFile(const std::vector<Appointment>& appointments, std::function<void()> onWritten = nullptr);
 
 // Loads all appointment records from file
 std::vector<Appointment> loadAllAppointmentsFromFile(const std::string& filename);
 
 // Returns all appointments associated with a specific pet ID
-std::vector<Appointment> getAppointmentsForPet(int petId);
+AppointmentView getAppointmentsForPet(int petId);
+
+// Re-reads one pet into petVaccinationStatus / vaccinationStatuses; call after
+// adding the pet or changing its vaccinations
+void indexVaccinationStatuses(const Pet& pet);
+void rebuildVaccinationStatuses(const std::vector<Pet>& pets);
+
+// Refills unassignedPetIds from the pet list (after loading)
+void rebuildUnassignedPets(const std::vector<Pet>& pets);
 
 // Displays a list of pets that are not assigned to any owner
 void displayUnassignedPets(const std::vector<Pet>& pets);
 
 // Displays full record details if the specified record exists
-bool displayFullRecordIfExists(const std::map<int, Record>& records, int recordId, const std::string& recordType);
+bool displayFullRecordIfExists(const RecordMap& records, int recordId, const std::string& recordType);
 
 // Prompts the user to view full details of a selected appointment
-void promptToViewFullAppointment(const std::vector<Appointment>& appointments);
+void promptToViewFullAppointment(const AppointmentView& appointments);
+
+// Prints what was loaded and the memory held by record text and interned strings (--stats)
+void printDataStats();
 
 #endif  // GLOBALS_H
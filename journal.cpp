@@ -0,0 +1,304 @@
+#include "journal.h"
+#include "globals.h"
+#include "persistence.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+#include <cstdint>
+#include <filesystem>
+#include <unordered_map>
+
+enum JournalKind { PET_JOURNAL, OWNER_JOURNAL, APPOINTMENT_JOURNAL, JOURNAL_KIND_COUNT };
+
+// One journal file per entity type, together with the number of records it holds.
+// While a compaction is being written out, the records it covers live in
+// compactingPath; they are deleted only once the rewritten CSV is on disk.
+struct JournalFile {
+    const char* path;
+    const char* compactingPath;
+    size_t records;
+};
+
+static JournalFile journalFiles[JOURNAL_KIND_COUNT] = {
+    { "pets.journal", "pets.journal.compacting", 0 },
+    { "owners.journal", "owners.journal.compacting", 0 },
+    { "appointments.journal", "appointments.journal.compacting", 0 },
+};
+
+// A validated record read back from a journal file
+struct JournalRecord {
+    char op;               // 'U' = insert/update (payload is a CSV row), 'D' = delete (payload is the ID)
+    std::string payload;
+};
+
+
+// Standard CRC-32 (IEEE 802.3), used to detect torn or corrupted journal records
+static uint32_t crc32(const std::string& data) {
+    static uint32_t table[256];
+    static bool tableReady = false;
+    if (!tableReady) {
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; ++k) {
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            table[i] = c;
+        }
+        tableReady = true;
+    }
+
+    uint32_t crc = 0xFFFFFFFFu;
+    for (unsigned char byte : data) {
+        crc = table[(crc ^ byte) & 0xFF] ^ (crc >> 8);
+    }
+    return crc ^ 0xFFFFFFFFu;
+}
+
+// Serializes an entity with its own CSV writer, without the trailing newline
+template <typename T>
+static std::string serializeRow(const T& entity) {
+    std::ostringstream row;
+    entity.writeToFileStream(row);
+    std::string text = row.str();
+    if (!text.empty() && text.back() == '\n') text.pop_back();
+    return text;
+}
+
+// Folds a journal into its CSV. The journal is moved aside (so new records go
+// to a fresh file) and the CSV rewrite is queued on the background writer; the
+// moved-aside records are deleted only after the new CSV is safely in place.
+// Returns false if an earlier save failed or the journal could not be moved aside.
+static bool compactJournal(JournalKind kind) {
+    JournalFile& journal = journalFiles[kind];
+
+    // an earlier compaction of this journal may still be in flight; a failed
+    // write stays flagged for the logout flush to report
+    bool ok = true;
+    if (std::filesystem::exists(journal.compactingPath)) ok = waitForPendingSaves();
+
+    // if it is still there, that write failed: keep both files and retry the CSV
+    // rewrite; replay reads the moved-aside records first, so nothing is lost
+    std::error_code ec;
+    if (!std::filesystem::exists(journal.compactingPath)) {
+        // that compaction went through and nothing was journaled since: done
+        if (journal.records == 0 && !std::filesystem::exists(journal.path)) return ok;
+
+        std::filesystem::rename(journal.path, journal.compactingPath, ec);
+        if (ec) {
+            std::cerr << "Error moving " << journal.path << " aside: " << ec.message() << "\n";
+            return false;
+        }
+        journal.records = 0;
+    }
+
+    std::string compactingPath = journal.compactingPath;
+    auto removeCompacted = [compactingPath] {
+        std::error_code removeError;
+        std::filesystem::remove(compactingPath, removeError);
+    };
+
+    switch (kind) {
+        case PET_JOURNAL:         saveAllPetsToFile(pets, "pets.csv", removeCompacted); break;
+        case OWNER_JOURNAL:       saveAllOwnersToFile(owners, "owners.csv", removeCompacted); break;
+        case APPOINTMENT_JOURNAL: saveAllAppointmentsToFile(appointments, removeCompacted); break;
+        default: break;
+    }
+    return ok;
+}
+
+static void appendRecord(JournalKind kind, char op, const std::string& payload) {
+    JournalFile& journal = journalFiles[kind];
+
+    std::string body = std::string(1, op) + " " + payload;
+    char crcHex[9];
+    std::snprintf(crcHex, sizeof(crcHex), "%08x", crc32(body));
+
+    std::ofstream file(journal.path, std::ios::app | std::ios::binary);
+    if (!file) {
+        std::cerr << "Error opening " << journal.path << " for writing.\n";
+        return;
+    }
+    file << crcHex << " " << body << "\n";
+    file.flush();
+    file.close();
+
+    if (++journal.records >= JOURNAL_COMPACT_THRESHOLD) {
+        compactJournal(kind);
+    }
+}
+
+
+void journalPet(const Pet& pet) {
+    appendRecord(PET_JOURNAL, 'U', serializeRow(pet));
+}
+
+void journalOwner(const Owner& owner) {
+    appendRecord(OWNER_JOURNAL, 'U', serializeRow(owner));
+}
+
+void journalAppointment(const Appointment& appt) {
+    appendRecord(APPOINTMENT_JOURNAL, 'U', serializeRow(appt));
+}
+
+void journalPetRemoval(int petId) {
+    appendRecord(PET_JOURNAL, 'D', std::to_string(petId));
+}
+
+void journalOwnerRemoval(int ownerId) {
+    appendRecord(OWNER_JOURNAL, 'D', std::to_string(ownerId));
+}
+
+void journalAppointmentRemoval(int appointmentId) {
+    appendRecord(APPOINTMENT_JOURNAL, 'D', std::to_string(appointmentId));
+}
+
+
+// Reads every valid record of a journal file. A record with a bad checksum ends
+// the read, and the file is cut back to the last good record so that new appends
+// are not written after garbage.
+static void readJournalFile(const char* path, std::vector<JournalRecord>& records) {
+    size_t firstRecord = records.size();
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file) return;
+
+    std::string line;
+    std::uintmax_t goodBytes = 0;
+    bool corrupted = false;
+    while (std::getline(file, line)) {
+        // layout: 8 hex digits of CRC, space, op, space, payload
+        bool valid = line.size() >= 11 && line[8] == ' ' && line[10] == ' ' && !file.eof();
+        if (valid) {
+            std::string body = line.substr(9);
+            uint32_t storedCrc = static_cast<uint32_t>(std::strtoul(line.substr(0, 8).c_str(), nullptr, 16));
+            valid = crc32(body) == storedCrc;
+        }
+        if (!valid) {
+            corrupted = true;
+            break;
+        }
+        records.push_back({ line[9], line.substr(11) });
+        goodBytes += line.size() + 1;
+    }
+    file.close();
+
+    if (corrupted) {
+        std::cerr << "⚠️ " << path << ": damaged record after " << records.size() - firstRecord
+                  << " valid record(s), discarding the rest.\n";
+        std::error_code ec;
+        std::filesystem::resize_file(path, goodBytes, ec);
+        if (ec) std::cerr << "Error truncating " << path << ": " << ec.message() << "\n";
+    }
+}
+
+// Reads a journal's records in the order they were written: those of an
+// unfinished compaction first, then the live journal
+static std::vector<JournalRecord> readJournal(JournalKind kind) {
+    std::vector<JournalRecord> records;
+    readJournalFile(journalFiles[kind].compactingPath, records);
+    size_t compacting = records.size();
+    readJournalFile(journalFiles[kind].path, records);
+
+    journalFiles[kind].records = records.size() - compacting;
+    return records;
+}
+
+// Applies journal records to an entity vector. Upserts replace the entity with
+// the same ID (or append a new one), deletes drop it; an ID -> slot map keeps
+// this linear in the size of the data plus the journal. nextId is raised past
+// every upserted ID.
+template <typename T, typename ParseRow, typename IdOf>
+static size_t applyRecords(const std::vector<JournalRecord>& records, std::vector<T>& items,
+                           ParseRow parseRow, IdOf idOf, int& nextId) {
+    if (records.empty()) return 0;
+
+    std::unordered_map<int, size_t> slotById;
+    for (size_t i = 0; i < items.size(); ++i) {
+        slotById[idOf(items[i])] = i;
+    }
+    std::vector<bool> removed(items.size(), false);
+
+    size_t applied = 0;
+    for (const auto& record : records) {
+        if (record.op == 'U') {
+            std::vector<T> parsed;
+            if (!parseRow(record.payload, parsed, std::cerr)) continue;
+
+            int id = idOf(parsed.front());
+            if (id >= nextId) nextId = id + 1;
+            auto it = slotById.find(id);
+            if (it != slotById.end()) {
+                items[it->second] = std::move(parsed.front());
+            } else {
+                slotById[id] = items.size();
+                items.push_back(std::move(parsed.front()));
+                removed.push_back(false);
+            }
+        } else if (record.op == 'D') {
+            int id;
+            try {
+                id = std::stoi(record.payload);
+            } catch (...) {
+                continue;
+            }
+            auto it = slotById.find(id);
+            if (it != slotById.end()) {
+                removed[it->second] = true;
+                slotById.erase(it);
+            }
+        } else {
+            continue;
+        }
+        applied++;
+    }
+
+    // drop deleted entities while keeping the original order
+    size_t kept = 0;
+    for (size_t i = 0; i < items.size(); ++i) {
+        if (removed[i]) continue;
+        if (kept != i) items[kept] = std::move(items[i]);
+        kept++;
+    }
+    items.erase(items.begin() + kept, items.end());
+
+    return applied;
+}
+
+size_t replayJournals() {
+    size_t applied = 0;
+
+    applied += applyRecords(readJournal(PET_JOURNAL), pets,
+                            [](const std::string& row, std::vector<Pet>& parsed, std::ostream& log) {
+                                return Pet::parseCsvLine(row, parsed, log);
+                            },
+                            [](const Pet& p) { return p.getPetId(); }, nextPetId);
+    applied += applyRecords(readJournal(OWNER_JOURNAL), owners,
+                            [](const std::string& row, std::vector<Owner>& parsed, std::ostream& log) {
+                                return Owner::parseCsvLine(row, parsed, log);
+                            },
+                            [](const Owner& o) { return o.getOwnerId(); }, nextOwnerId);
+    applied += applyRecords(readJournal(APPOINTMENT_JOURNAL), appointments, &Appointment::parseCsvLine,
+                            [](const Appointment& a) { return a.getAppointmentId(); }, nextAppointmentId);
+
+    // finish compactions a previous run did not get to write out, and fold
+    // oversized journals back into the base files right away
+    for (int kind = 0; kind < JOURNAL_KIND_COUNT; ++kind) {
+        if (journalFiles[kind].records >= JOURNAL_COMPACT_THRESHOLD
+            || std::filesystem::exists(journalFiles[kind].compactingPath)) {
+            compactJournal(static_cast<JournalKind>(kind));
+        }
+    }
+
+    return applied;
+}
+
+bool compactJournals() {
+    bool ok = true;
+    for (int kind = 0; kind < JOURNAL_KIND_COUNT; ++kind) {
+        if (journalFiles[kind].records > 0 || std::filesystem::exists(journalFiles[kind].compactingPath)) {
+            if (!compactJournal(static_cast<JournalKind>(kind))) ok = false;
+        }
+    }
+    return ok;
+}
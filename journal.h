@@ -0,0 +1,39 @@
+#ifndef JOURNAL_H
+#define JOURNAL_H
+
+#include <string>
+#include "Pet.h"
+#include "Owner.h"
+#include "Appointment.h"
+
+// Append-only write-ahead journal for pets, owners and appointments.
+// Every mutation appends one checksummed record ("<crc32> <op> <payload>") to
+// the entity's journal file instead of rewriting the whole CSV. Journals are
+// replayed on top of the base CSVs at startup and folded back into them by
+// compaction once they grow past JOURNAL_COMPACT_THRESHOLD records.
+
+// Number of journal records after which an entity's journal is compacted
+const size_t JOURNAL_COMPACT_THRESHOLD = 500;
+
+// Records the current state of a pet / owner / appointment (insert or update)
+void journalPet(const Pet& pet);
+void journalOwner(const Owner& owner);
+void journalAppointment(const Appointment& appt);
+
+// Records the removal of a pet / owner / appointment by ID
+void journalPetRemoval(int petId);
+void journalOwnerRemoval(int ownerId);
+void journalAppointmentRemoval(int appointmentId);
+
+// Applies all journal records on top of the data loaded from the CSV files and
+// advances the next-ID counters past any replayed IDs.
+// Stops at the first record with a bad checksum (e.g. a torn write after a crash).
+// Returns the number of records replayed.
+size_t replayJournals();
+
+// Queues a rewrite of the base CSV files from memory; each journal is discarded
+// once its CSV has been written (see flushPendingSaves in persistence.h).
+// Returns false if an earlier save failed or a journal could not be moved aside.
+bool compactJournals();
+
+#endif  // JOURNAL_H
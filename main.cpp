@@ -9,17 +9,74 @@
 #include "globals.h"
 #include <unordered_map>
 #include <algorithm>
+#include <future>
 #include "validations.h"
 #include "hashing.h"
+#include "journal.h"
+#include "snapshot.h"
+#include "persistence.h"
 
-int main() {
+int main(int argc, char* argv[]) {
 
     std::cout << "\033[1m;31mHElLo\033[0m\n";
-    // Load global data once at startup
-    users = User::loadFromFile("users.csv");
-    pets = Pet::loadFromFile("pets.csv");
-    owners = Owner::loadFromFile("owners.csv");
-    appointments = Appointment::loadFromFile("appointments.csv");
+    bool writeSnapshotAndExit = argc > 1 && std::string(argv[1]) == "--snapshot";
+    // --validate-owners <file>: report duplicate phone numbers / emails in an import file
+    std::string ownersToValidate = argc > 2 && std::string(argv[1]) == "--validate-owners" ? argv[2] : "";
+    // --stats: report what was loaded and how much memory the record text takes
+    bool printStatsAndExit = argc > 1 && std::string(argv[1]) == "--stats";
+
+    // Load global data once at startup, from the binary snapshot when it is newer than the CSVs
+    bool loadedSnapshot = snapshotIsFresh(SNAPSHOT_FILE) && loadSnapshot(SNAPSHOT_FILE);
+    if (!loadedSnapshot) {
+        // The files are independent, so each is loaded on its own thread;
+        // every loader also syncs its own next ID counter.
+        auto usersLoad = std::async(std::launch::async, [] { return User::loadFromFile("users.csv", nextUserId, usernameIndex); });
+        auto petsLoad = std::async(std::launch::async, [] { return Pet::loadFromFile("pets.csv", nextPetId); });
+        auto ownersLoad = std::async(std::launch::async, [] { return Owner::loadFromFile("owners.csv", nextOwnerId); });
+        auto appointmentsLoad = std::async(std::launch::async,
+            [] { return Appointment::loadFromFile("appointments.csv", nextAppointmentId); });
+
+        users = usersLoad.get();
+        pets = petsLoad.get();
+        owners = ownersLoad.get();
+        appointments = appointmentsLoad.get();
+    }
+
+    // Bring the loaded data up to date with changes journaled since the last compaction
+    size_t replayed = replayJournals();
+    if (replayed > 0) {
+        std::cout << "ℹ️ Replayed " << replayed << " journaled change(s).\n";
+    }
+    petIndex.rebuild(pets);
+    ownerIndex.rebuild(owners);
+    appointmentIndex.rebuild(appointments);
+    ownerContacts.rebuild(owners);
+    petNames.rebuild(pets);
+    ownerNames.rebuild(owners);
+    fuzzyPets.rebuild(pets);
+    fuzzyOwners.rebuild(owners);
+    vaccinationQueue.rebuild(pets);
+    rebuildUnassignedPets(pets);
+    rebuildVaccinationStatuses(pets);
+
+    if (!ownersToValidate.empty()) {
+        return validateOwnerFile(ownersToValidate, ownerContacts);
+    }
+
+    if (printStatsAndExit) {
+        printDataStats();
+        return 0;
+    }
+
+    if (writeSnapshotAndExit) {
+        // fold the journals into the CSVs first so the snapshot is newer than all of them
+        bool compacted = compactJournals();
+        if (!flushPendingSaves() || !compacted || !writeSnapshot(SNAPSHOT_FILE)) return 1;
+        std::cout << "✅ Snapshot written to " << SNAPSHOT_FILE << " (" << pets.size() << " pets, "
+                  << owners.size() << " owners, " << appointments.size() << " appointments, "
+                  << users.size() << " users).\n";
+        return 0;
+    }
 
     // std::cout << "[main] users.size(): " << users.size() << "\n";
 
@@ -29,16 +86,6 @@ int main() {
     //     std::cout << u->getUsername() << " => " << u->getPassword() << "\n";
     // }
 
-    // Sync next ID counters
-    for (const auto& p : pets)
-        if (p.getPetId() >= nextPetId) nextPetId = p.getPetId() + 1;
-    for (const auto& o : owners)
-        if (o.getOwnerId() >= nextOwnerId) nextOwnerId = o.getOwnerId() + 1;
-    for (const auto& a : appointments)
-        if (a.getAppointmentId() >= nextAppointmentId) nextAppointmentId = a.getAppointmentId() + 1;
-    for (const auto& u : users)
-        if (u->getId() >= nextUserId) nextUserId = u->getId() + 1;
-
     // Login Section
     int totalLoginAttempts = 0;
     const int MAX_TOTAL_ATTEMPTS = 3;
@@ -57,29 +104,13 @@ int main() {
             std::getline(std::cin, enteredUsername);
 
             rawPassword = getHiddenPassword("Enter Password: ");
-            std::string hashedInput = sha256(rawPassword);
-
-            std::string trimmedUsername = trim(enteredUsername);
-            std::string lowerUsername = toLower(trimmedUsername);
-
-            for (const auto& u : users) {
-                if (toLower(trim(u->getUsername())) == lowerUsername) {
-                    // std::cout << "AUTH Comparing with stored: " << u->getUsername()
-                    //           << " => " << u->getPassword() << "\n";
-                    // std::cout << "Comparing hashes:\nEntered: " << hashedInput
-                    //           << "\nStored : " << u->getPassword() << "\n";
-
-                    if (hashedInput == u->getPassword()) {
-                        loggedInUser = u.get();
-                        break;
-                    }
-                }
-            }
+            loggedInUser = User::authenticateUser(usernameIndex, enteredUsername, rawPassword);
 
             if (!loggedInUser) {
                 totalLoginAttempts++;
                 if (totalLoginAttempts >= MAX_TOTAL_ATTEMPTS) {
                     std::cout << "\n❌ Too many failed login attempts. System is shutting down for security reasons.\n";
+                    flushPendingSaves();
                     return 1;
                 }
 
@@ -98,6 +129,14 @@ int main() {
         std::cout << "=============================================\n";
 
         mainMenu(*loggedInUser); // Polymorphic menu based on role
+
+        // Fold this session's journaled changes back into the CSV files on logout
+        // and wait until everything queued for the background writer is on disk
+        bool compacted = compactJournals();
+        if (!flushPendingSaves() || !compacted) {
+            std::cerr << "⚠️ Some files could not be written, see the errors above.\n";
+        }
+        reportPetSaveStats();
     }
 
     return 0;
@@ -0,0 +1,68 @@
+#include "mapped_file.h"
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+MappedFile::MappedFile(const std::string& filename) {
+    fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd == -1) return;
+
+    struct stat info;
+    if (::fstat(fd, &info) == -1) {
+        release();
+        return;
+    }
+
+    length = static_cast<size_t>(info.st_size);
+    if (length == 0) return; // mmap rejects zero-length mappings, an empty view is enough
+
+    void* mapped = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapped == MAP_FAILED) {
+        release();
+        return;
+    }
+    data = static_cast<const char*>(mapped);
+    ::madvise(mapped, length, MADV_SEQUENTIAL);
+}
+
+MappedFile::~MappedFile() {
+    release();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : fd(other.fd), data(other.data), length(other.length) {
+    other.fd = -1;
+    other.data = nullptr;
+    other.length = 0;
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        release();
+        fd = other.fd;
+        data = other.data;
+        length = other.length;
+        other.fd = -1;
+        other.data = nullptr;
+        other.length = 0;
+    }
+    return *this;
+}
+
+void MappedFile::release() {
+    if (data) ::munmap(const_cast<char*>(data), length);
+    if (fd != -1) ::close(fd);
+    fd = -1;
+    data = nullptr;
+    length = 0;
+}
+
+
+std::string_view nextLine(std::string_view text, size_t& pos) {
+    size_t end = text.find('\n', pos);
+    if (end == std::string_view::npos) end = text.size();
+    std::string_view line = text.substr(pos, end - pos);
+    pos = end < text.size() ? end + 1 : end;
+    return line;
+}
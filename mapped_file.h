@@ -0,0 +1,39 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <string>
+#include <string_view>
+#include <cstddef>
+
+// Read-only memory mapping of a whole file (POSIX mmap).
+// The mapping is released when the object is destroyed; views returned by
+// view() are only valid while the MappedFile is alive.
+class MappedFile {
+    int fd = -1;
+    const char* data = nullptr;
+    size_t length = 0;
+
+public:
+    MappedFile() = default;
+    explicit MappedFile(const std::string& filename);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    // True if the file could be opened (an empty file is open with size 0)
+    bool isOpen() const { return fd != -1; }
+    size_t size() const { return length; }
+    std::string_view view() const { return std::string_view(data, length); }
+
+private:
+    void release();
+};
+
+// Returns the next line of text and advances pos past its '\n'.
+// A trailing '\r' is kept, matching std::getline.
+std::string_view nextLine(std::string_view text, size_t& pos);
+
+#endif  // MAPPED_FILE_H
@@ -69,10 +69,12 @@ void petMenu(User& user) {
         std::cout << (user.canManageAppointments() ? "8. 📅 Manage Pet Appointments\n" : "8. 📅 Manage Pet Appointments (🚫 Restricted)\n");
         std::cout << (user.canDeletePet() ? "9. 🗑️  Delete a Pet\n" : "9. 🗑️  Delete a Pet (🚫 Restricted)\n");
         std::cout << (user.canDeletePet() || user.getRole() == "Staff" ? "10. 🔗 Link Unassigned Pet to Owner\n" : "10. 🔗 Link Unassigned Pet to Owner (🚫 Restricted)\n");
+        std::cout << "11. 🔎 Search Records (Full Text)\n";
+        std::cout << "12. 🔤 Search Pets by Name/Breed\n";
 
         std::cout << "0. 🔙 Return to Main Menu\n";
 
-        choice = askForMenuChoice(0, 10, "Enter your choice: ");
+        choice = askForMenuChoice(0, 12, "Enter your choice: ");
 
         switch (choice) {
             case 1: addNewPet(); break;
@@ -113,6 +115,8 @@ void petMenu(User& user) {
                     std::cout << "❌ Access denied.\n";
                 }
                 break;
+            case 11: searchRecords(user.canManageMedicalRecords()); break;
+            case 12: searchPetsByName(); break;
             case 0:
                 std::cout << "🔙 Returning to Main Menu...\n";
                 break;
@@ -137,9 +141,10 @@ void ownerMenu(User& user) {
         std::cout << "6. 🐾 View Pets Linked to an Owner\n";
         std::cout << "7. 📁 Manage Owner Records" << (user.canManageOwnerRecords() ? "" : " (🚫 Restricted)") << "\n";
         std::cout << "8. 📅 Manage Appointments" << (user.canManageAppointments() ? "" : " (🚫 Restricted)") << "\n";
+        std::cout << "9. 🔤 Search Owners by Name\n";
         std::cout << "0. 🔙 Return to Main Menu\n";
 
-        choice = askForMenuChoice(0, 8, "Enter your choice: ");
+        choice = askForMenuChoice(0, 9, "Enter your choice: ");
 
         switch (choice) {
             case 1:
@@ -165,6 +170,7 @@ void ownerMenu(User& user) {
                 if (user.canManageAppointments()) manageOwnerAppointments();
                 else std::cout << "❌ Access denied.\n";
                 break;
+            case 9: searchOwnersByName(); break;
             case 0: std::cout << "🔙 Returning to Main Menu...\n"; break;
             default: std::cout << "❌ Invalid choice.\n"; break;
         }
@@ -183,9 +189,12 @@ void appointmentMenu(User& user) {
         std::cout << "5. ➕ Add Appointment" << (user.canManageAppointments() ? "" : " (🚫 Restricted)") << "\n";
         std::cout << "6. ✏️  Update Appointment Status" << (user.canManageAppointments() ? "" : " (🚫 Restricted)") << "\n";
         std::cout << "7. 🗑️  Delete Appointment" << (user.canDeletePet() ? "" : " (🚫 Restricted)") << "\n";
+        std::cout << "8. 🗓️  Calendar View (Date Range)\n";
+        std::cout << "9. 🕒 Find Next Free Slots\n";
+        std::cout << "10. 📊 Status Dashboard\n";
         std::cout << "0. 🔙 Return to Main Menu\n";
 
-        choice = askForMenuChoice(0, 7, "Enter your choice: ");
+        choice = askForMenuChoice(0, 10, "Enter your choice: ");
 
         switch (choice) {
             case 1: viewAllAppointments(appointments); break;
@@ -204,6 +213,9 @@ void appointmentMenu(User& user) {
                 if (user.canDeletePet()) deleteAppointment(appointments);
                 else std::cout << "❌ Access denied.\n";
                 break;
+            case 8: viewAppointmentCalendar(appointments); break;
+            case 9: findNextFreeSlots(); break;
+            case 10: viewStatusDashboard(); break;
             case 0: std::cout << "🔙 Returning to Main Menu...\n"; break;
         }
     } while (choice != 0);
@@ -2,6 +2,9 @@
 #include <iostream>
 #include "validations.h"
 #include "globals.h"
+#include "journal.h"
+#include <chrono>
+#include <iomanip>
 
 void addNewOwner() {
     while (true) {
@@ -27,15 +30,8 @@ void addNewOwner() {
                 std::cout << "❌ Owner creation cancelled.\n";
                 return;
             }
-            bool exists = false;
-            for (const auto& o : owners) {
-                if (o.getPhoneNumber() == phone) {
-                    std::cout << "❌ An owner with that phone number already exists. Please enter a different one.\n";
-                    exists = true;
-                    break;
-                }
-            }
-            if (!exists) break; // valid, not duplicate
+            if (!isPhoneNumberTaken(phone)) break; // valid, not duplicate
+            std::cout << "❌ An owner with that phone number already exists. Please enter a different one.\n";
         }
 
 
@@ -48,22 +44,19 @@ void addNewOwner() {
                 std::cout << "❌ Owner creation cancelled.\n";
                 return;
             }
-            bool exists = false;
-            for (const auto& o : owners) {
-                if (o.getEmail() == email) {
-                    std::cout << "❌ An owner with that email already exists. Please enter a different one.\n";
-                    exists = true;
-                    break;
-                }
-            }
-            if (!exists) break; // valid, not duplicate
+            if (!isEmailTaken(email)) break; // valid, not duplicate
+            std::cout << "❌ An owner with that email already exists. Please enter a different one.\n";
 
         }
 
         ownerId = nextOwnerId;
         Owner owner(ownerId, name, address, phone, email);
         owners.push_back(owner);
-        saveAllOwnersToFile(owners);
+        ownerIndex.insert(ownerId, owners.size() - 1);
+        ownerContacts.add(owners.back());
+        ownerNames.assign(ownerId, { name });
+        fuzzyOwners.index(owners.back());
+        journalOwner(owners.back());
         nextOwnerId++;
 
         std::cout << "✅ New owner added successfully! (🆔: " << ownerId << ")\n";
@@ -112,17 +105,14 @@ void viewOwnerDetailsById() {
         int id = askForValidId("🔍 Enter Owner 🆔 to view details (or press Enter/0 to return): ");
         if (id == 0) break;
 
-        auto it = std::find_if(owners.begin(), owners.end(), [&](const Owner& o) {
-            return o.getOwnerId() == id;
-        });
-
-        if (it == owners.end()) {
+        const Owner* owner = findOwnerById(owners, id);
+        if (!owner) {
             std::cout << "❌ Owner with 🆔 " << id << " not found. Please try again.\n";
             continue;
         }
 
-        it->displayOwnerDetails();
-        it->displayLinkedPets(pets);
+        owner->displayOwnerDetails();
+        owner->displayLinkedPets(pets);
 
         std::cout << "===============================\n";
 
@@ -170,16 +160,9 @@ void updateOwner() {
                 return;
             }
             // Only check uniqueness if user provided a new value
-            if (!newPhone.empty() && newPhone != owner->getPhoneNumber()) {
-                bool exists = false;
-                for (const auto& o : owners) {
-                    if (o.getPhoneNumber() == newPhone && o.getOwnerId() != owner->getOwnerId()) {
-                        std::cout << "❌ Another owner already has that phone number. Please enter a different one.\n";
-                        exists = true;
-                        break;
-                    }
-                }
-                if (exists) continue;
+            if (!newPhone.empty() && isPhoneNumberTaken(newPhone, owner->getOwnerId())) {
+                std::cout << "❌ Another owner already has that phone number. Please enter a different one.\n";
+                continue;
             }
             break;
         }
@@ -193,16 +176,9 @@ void updateOwner() {
                 return;
             }
 
-            if (!newEmail.empty() && newEmail != owner->getEmail()) {
-                bool exists = false;
-                for (const auto& o : owners) {
-                    if (o.getEmail() == newEmail && o.getOwnerId() != owner->getOwnerId()) {
-                        std::cout << "❌ Another owner already has that email. Please enter a different one.\n";
-                        exists = true;
-                        break;
-                    }
-                }
-                if (exists) continue;
+            if (!newEmail.empty() && isEmailTaken(newEmail, owner->getOwnerId())) {
+                std::cout << "❌ Another owner already has that email. Please enter a different one.\n";
+                continue;
             }
             break;
         }
@@ -215,12 +191,18 @@ void updateOwner() {
         std::cout << "📧 Email        : " << (newEmail.empty() ? owner->getEmail() : newEmail) << "\n";
 
         if (promptYesNo("✅ Apply these changes?")) {
-            if (!newName.empty()) owner->setName(newName);
+            if (!newName.empty()) {
+                owner->setName(newName);
+                ownerNames.assign(id, { newName });
+                fuzzyOwners.index(*owner);
+            }
             if (!newAddress.empty()) owner->setAddress(newAddress);
+            ownerContacts.remove(*owner);
             if (!newPhone.empty()) owner->setPhoneNumber(newPhone);
             if (!newEmail.empty()) owner->setEmail(newEmail);
+            ownerContacts.add(*owner);
 
-            saveAllOwnersToFile(owners);
+            journalOwner(*owner);
             std::cout << "✅ Owner updated successfully.\n";
         } else {
             std::cout << "❌ Update cancelled.\n";
@@ -259,8 +241,7 @@ void deleteOwner() {
                       << " linked pet(s). They will be unassigned but NOT deleted.\n";
         }
 
-        int linkedApptCount = std::count_if(appointments.begin(), appointments.end(),
-            [id](const Appointment& appt) { return appt.getOwnerId() == id; });
+        size_t linkedApptCount = appointmentIndex.countForOwner(id);
         if (linkedApptCount > 0) {
             std::cout << "📅 This owner is linked to " << linkedApptCount
                       << " appointment(s). They will be unassigned as well.\n";
@@ -273,22 +254,26 @@ void deleteOwner() {
 
         for (int petId : linkedPetIds) {
             Pet* pet = findPetById(pets, petId);
-            if (pet) pet->setOwnerId(-1);
-        }
-
-        for (auto& appt : appointments) {
-            if (appt.getOwnerId() == id) {
-                appt.setOwnerId(-1);
+            if (pet) {
+                pet->setOwnerId(-1);
+                unassignedPetIds.insert(petId);
+                journalPet(*pet);
             }
         }
 
-        owners.erase(std::remove_if(owners.begin(), owners.end(),
-            [id](const Owner& o) { return o.getOwnerId() == id; }),
-            owners.end());
+        for (Appointment* appt : appointmentIndex.editableForOwner(appointments, id)) {
+            appt->setOwnerId(-1);
+            appointmentIndex.update(*appt);
+            journalAppointment(*appt);
+        }
 
-        saveAllOwnersToFile(owners);
-        saveAllPetsToFile(pets);
-        saveAllAppointmentsToFile(appointments);
+        journalOwnerRemoval(id);
+        ownerContacts.remove(*owner);
+        ownerNames.remove(id);
+        fuzzyOwners.remove(id);
+        textIndex.removeEntity(RecordSource::OwnerRecord, id);
+        owners.erase(owners.begin() + (owner - owners.data()));
+        ownerIndex.rebuild(owners);   // later owners shifted down a slot
 
         std::cout << "✅ Owner and all links removed successfully.\n";
 
@@ -384,7 +369,7 @@ void manageOwnerRecords() {
                 }
 
                 owner->addRecord(date, details);
-                saveAllOwnersToFile(owners);
+                journalOwner(*owner);
                 std::cout << "✅ Record added successfully.\n";
 
                 if (!promptYesNo("➕ Add another record?")) break;
@@ -483,7 +468,7 @@ void manageOwnerRecords() {
                     if (newDetails.empty()) newDetails = current.getDetails();
 
                     owner->updateRecord(recordId, newDate, newDetails);
-                    saveAllOwnersToFile(owners);
+                    journalOwner(*owner);
                     std::cout << "✅ Record updated successfully.\n";
 
                     if (!promptYesNo("✏️  Update another record?")) break;
@@ -524,7 +509,7 @@ void manageOwnerRecords() {
 
                     if (promptYesNo("❗ Are you sure you want to delete this record?")) {
                         owner->deleteRecord(recordId);
-                        saveAllOwnersToFile(owners);
+                        journalOwner(*owner);
                         std::cout << "✅ Record deleted successfully.\n";
 
                         if (!owner->hasRecords()) {
@@ -606,7 +591,7 @@ void manageOwnerAppointments() {
                     continue;
                 }
 
-                std::string time = askForValidAppointmentTime("⏰ Enter appointment time (HH:MM) (or press Enter/0 to return): ");
+                std::string time = askForFreeAppointmentTime(date, "⏰ Enter appointment time (HH:MM) (or press Enter/0 to return): ");
                 if (time.empty()) {
                     std::cout << "❌ Appointment creation cancelled.\n";
                     continue;
@@ -622,7 +607,8 @@ void manageOwnerAppointments() {
                 int appointmentId = nextAppointmentId++;
 
                 appointments.emplace_back(appointmentId, ownerId, petId, date, time, purpose, status);
-                saveAllAppointmentsToFile(appointments);
+                appointmentIndex.add(appointments.back(), appointments.size() - 1);
+                journalAppointment(appointments.back());
 
                 std::cout << "✅ Appointment (ID: " << appointmentId << ") created successfully.\n";
 
@@ -636,12 +622,7 @@ void manageOwnerAppointments() {
                 int ownerId = askForValidId("🆔 Enter Owner ID to view appointments (or press Enter/0 to return): ");
                 if (ownerId == 0) break;
 
-                std::vector<Appointment> ownerAppointments;
-                for (const auto& appt : appointments) {
-                    if (appt.getOwnerId() == ownerId) {
-                        ownerAppointments.push_back(appt);
-                    }
-                }
+                AppointmentView ownerAppointments = appointmentIndex.forOwner(appointments, ownerId);
 
                 if (ownerAppointments.empty()) {
                     std::cout << "ℹ️ No appointments found for Owner ID " << ownerId << ".\n";
@@ -656,10 +637,10 @@ void manageOwnerAppointments() {
                         if (apptId == 0) break;
 
                         auto it = std::find_if(ownerAppointments.begin(), ownerAppointments.end(),
-                            [apptId](const Appointment& a) { return a.getAppointmentId() == apptId; });
+                            [apptId](const Appointment* a) { return a->getAppointmentId() == apptId; });
 
                         if (it != ownerAppointments.end()) {
-                            it->displayAppointmentDetails();
+                            (*it)->displayAppointmentDetails();
                         } else {
                             std::cout << "❌ Appointment ID not found. Please try again.\n";
                         }
@@ -676,12 +657,7 @@ void manageOwnerAppointments() {
                 int ownerId = askForValidId("🆔 Enter Owner ID to update appointment (or press Enter/0 to return): ");
                 if (ownerId == 0) break;
 
-                std::vector<Appointment*> ownerAppointments;
-                for (auto& appt : appointments) {
-                    if (appt.getOwnerId() == ownerId) {
-                        ownerAppointments.push_back(&appt);
-                    }
-                }
+                std::vector<Appointment*> ownerAppointments = appointmentIndex.editableForOwner(appointments, ownerId);
 
                 if (ownerAppointments.empty()) {
                     std::cout << "ℹ️ No appointments found for Owner ID " << ownerId << ".\n";
@@ -716,7 +692,8 @@ void manageOwnerAppointments() {
                     }
 
                     appt->updateStatus(status);
-                    saveAllAppointmentsToFile(appointments);
+                    appointmentIndex.update(*appt);
+                    journalAppointment(*appt);
                     std::cout << "✅ Appointment status updated successfully.\n";
 
                     if (!promptYesNo("✏️ Update another appointment for this owner?")) break;
@@ -728,4 +705,51 @@ void manageOwnerAppointments() {
     }
 
     std::cout << "↩️ Returning to the previous menu...\n";
-}
\ No newline at end of file
+}
+
+void searchOwnersByName() {
+    while (true) {
+        std::cout << "\n🔎 Enter the start of an owner's name (or press Enter/0 to return): ";
+        std::string prefix;
+        std::getline(std::cin, prefix);
+        prefix = trim(prefix);
+        if (prefix.empty() || prefix == "0") break;
+
+        auto start = std::chrono::steady_clock::now();
+        std::vector<int> ids = ownerNames.findPrefix(prefix, 20);
+        std::vector<FuzzyMatch> close;
+        if (ids.empty()) {
+            // maybe a typo: list the closest names instead
+            close = fuzzyOwners.search(prefix, 10);
+            for (const auto& m : close) ids.push_back(m.id);
+        }
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        if (ids.empty()) {
+            std::cout << "📭 No owners match \"" << prefix << "\".\n";
+        } else {
+            if (!close.empty()) std::cout << "🤔 No names start with \"" << prefix << "\". Closest matches:\n";
+            std::cout << "-----------------------------------------------------------------------------------\n";
+            std::cout << std::left
+                      << std::setw(7)  << "ID"
+                      << std::setw(25) << "Name"
+                      << std::setw(18) << "Phone"
+                      << "Email" << "\n";
+            std::cout << "-----------------------------------------------------------------------------------\n";
+            for (int id : ids) {
+                const Owner* o = findOwnerById(owners, id);
+                if (!o) continue;
+                std::cout << std::left
+                          << std::setw(7)  << o->getOwnerId()
+                          << std::setw(25) << o->getName()
+                          << std::setw(18) << o->getPhoneNumber()
+                          << o->getEmail() << "\n";
+            }
+            std::cout << "-----------------------------------------------------------------------------------\n";
+            std::cout << "📊 Showing " << ids.size() << " match(es), found in " << std::setprecision(3) << ms << " ms.\n";
+            std::cout << std::setprecision(6);
+        }
+
+        if (!promptYesNo("🔁 Would you like to search again?")) break;
+    }
+}
@@ -29,4 +29,8 @@ void manageOwnerRecords();
 // Displays and manages appointments linked to a specific owner.
 void manageOwnerAppointments();
 
+// Lists owners whose name has a word starting with the typed text,
+// or the closest names (typos allowed) if none does
+void searchOwnersByName();
+
 #endif  // owner_helper
\ No newline at end of file
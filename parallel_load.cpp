@@ -0,0 +1,37 @@
+#include "parallel_load.h"
+#include <iostream>
+#include <mutex>
+#include <thread>
+
+std::vector<std::string_view> splitAtLines(std::string_view text, size_t parts) {
+    std::vector<std::string_view> chunks;
+    if (parts < 1) parts = 1;
+
+    size_t target = text.size() / parts;
+    size_t begin = 0;
+    while (begin < text.size()) {
+        size_t end = text.size();
+        if (chunks.size() + 1 < parts) {
+            // move the cut forward to the end of the line it falls in
+            size_t newline = text.find('\n', std::min(begin + target, text.size()));
+            if (newline != std::string_view::npos) end = newline + 1;
+        }
+        chunks.push_back(text.substr(begin, end - begin));
+        begin = end;
+    }
+
+    if (chunks.empty()) chunks.push_back(text);
+    return chunks;
+}
+
+size_t parseChunkCount(size_t bytes) {
+    if (bytes < PARALLEL_PARSE_MIN_BYTES) return 1;
+    size_t cores = std::thread::hardware_concurrency();
+    return cores > 0 ? cores : 1;
+}
+
+void writeLoadLog(const std::string& text) {
+    static std::mutex logMutex;
+    std::lock_guard<std::mutex> lock(logMutex);
+    std::cerr << text;
+}
@@ -0,0 +1,86 @@
+#ifndef PARALLEL_LOAD_H
+#define PARALLEL_LOAD_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <sstream>
+#include <future>
+#include <algorithm>
+#include <memory>
+#include "mapped_file.h"
+#include "TextArena.h"
+
+// CSV bodies smaller than this are parsed on the calling thread;
+// larger ones are split into line-aligned chunks parsed concurrently.
+const size_t PARALLEL_PARSE_MIN_BYTES = 1 << 20;
+
+// Splits text into at most `parts` consecutive ranges, each ending just after a '\n'
+// (the last one ends at the end of the text). Concatenated, the ranges give back the text.
+std::vector<std::string_view> splitAtLines(std::string_view text, size_t parts);
+
+// Number of chunks to split a CSV body of the given size into
+size_t parseChunkCount(size_t bytes);
+
+// Writes loader diagnostics to std::cerr in one piece, so messages from files
+// loaded on different threads do not interleave
+void writeLoadLog(const std::string& text);
+
+// Parses every line of a CSV body (header already removed) with
+// parseLine(line, items, log, chunkText), chunking large bodies across threads.
+// Entities keep their file order. nextId is raised past the highest ID seen
+// while parsing, so no separate pass is needed to sync the ID counters.
+// Each chunk stores the text it keeps in its own arena (chunkText); `text`
+// adopts those arenas once every chunk is parsed.
+template <typename T, typename ParseLine, typename IdOf>
+std::vector<T> parseCsvBody(std::string_view body, ParseLine parseLine, IdOf idOf, int& nextId, TextArena& text) {
+    struct ChunkResult {
+        std::vector<T> items;
+        std::string log;
+        int highestId = 0;
+        std::unique_ptr<TextArena> text = std::make_unique<TextArena>();
+    };
+
+    auto parseChunk = [&parseLine, &idOf](std::string_view chunk) {
+        ChunkResult result;
+        std::ostringstream log;
+        size_t pos = 0;
+        while (pos < chunk.size()) {
+            if (parseLine(nextLine(chunk, pos), result.items, log, *result.text)) {
+                result.highestId = std::max(result.highestId, idOf(result.items.back()));
+            }
+        }
+        result.log = log.str();
+        return result;
+    };
+
+    std::vector<std::string_view> chunks = splitAtLines(body, parseChunkCount(body.size()));
+    std::vector<ChunkResult> results;
+    if (chunks.size() == 1) {
+        results.push_back(parseChunk(chunks.front()));
+    } else {
+        std::vector<std::future<ChunkResult>> pending;
+        for (std::string_view chunk : chunks) {
+            pending.push_back(std::async(std::launch::async, parseChunk, chunk));
+        }
+        for (auto& f : pending) results.push_back(f.get());
+    }
+
+    size_t total = 0;
+    for (const auto& r : results) total += r.items.size();
+
+    std::vector<T> items;
+    items.reserve(total);
+    std::string log;
+    for (auto& r : results) {
+        std::move(r.items.begin(), r.items.end(), std::back_inserter(items));
+        log += r.log;
+        if (r.highestId >= nextId) nextId = r.highestId + 1;
+        text.adopt(*r.text);
+    }
+    if (!log.empty()) writeLoadLog(log);
+
+    return items;
+}
+
+#endif  // PARALLEL_LOAD_H
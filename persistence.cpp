@@ -0,0 +1,165 @@
+#include "persistence.h"
+#include <iostream>
+#include <deque>
+#include <algorithm>
+#include <vector>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <filesystem>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+// One pending file write, with the callbacks of every save coalesced into it
+struct SaveJob {
+    std::string filename;
+    std::string contents;
+    std::vector<std::function<void()>> onWritten;
+};
+
+bool writeFileAtomically(const std::string& filename, const std::string& contents) {
+    std::string tempName = filename + ".tmp";
+
+    int fd = ::open(tempName.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd == -1) {
+        std::cerr << "Error opening " << tempName << " for writing: " << std::strerror(errno) << "\n";
+        return false;
+    }
+
+    size_t written = 0;
+    while (written < contents.size()) {
+        ssize_t n = ::write(fd, contents.data() + written, contents.size() - written);
+        if (n == -1) {
+            if (errno == EINTR) continue;
+            std::cerr << "Error writing " << tempName << ": " << std::strerror(errno) << "\n";
+            ::close(fd);
+            ::unlink(tempName.c_str());
+            return false;
+        }
+        written += static_cast<size_t>(n);
+    }
+
+    if (::fsync(fd) == -1 || ::close(fd) == -1) {
+        std::cerr << "Error flushing " << tempName << ": " << std::strerror(errno) << "\n";
+        ::unlink(tempName.c_str());
+        return false;
+    }
+
+    if (::rename(tempName.c_str(), filename.c_str()) == -1) {
+        std::cerr << "Error replacing " << filename << ": " << std::strerror(errno) << "\n";
+        ::unlink(tempName.c_str());
+        return false;
+    }
+
+    std::string dir = std::filesystem::path(filename).parent_path().string();
+    int dirFd = ::open(dir.empty() ? "." : dir.c_str(), O_RDONLY);
+    if (dirFd != -1) {
+        ::fsync(dirFd);
+        ::close(dirFd);
+    }
+    return true;
+}
+
+
+class PersistenceWorker {
+    std::mutex mutex;
+    std::condition_variable wake;      // signalled when a job is queued or on shutdown
+    std::condition_variable idle;      // signalled when the queue drains
+    std::deque<SaveJob> queue;
+    bool busy = false;                 // a job has been taken and is being written
+    bool stopping = false;
+    bool failed = false;               // a write failed since the last flush
+    std::thread worker;                // declared last, so it starts after the state above
+
+public:
+    PersistenceWorker() : worker(&PersistenceWorker::run, this) {}
+
+    // Drains the queue before the program exits, whichever way main() returns
+    ~PersistenceWorker() {
+        flush();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_one();
+        worker.join();
+    }
+
+    void enqueue(const std::string& filename, std::string contents, std::function<void()> onWritten) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto pending = std::find_if(queue.begin(), queue.end(),
+                [&filename](const SaveJob& job) { return job.filename == filename; });
+            if (pending != queue.end()) {
+                // not started yet: the newer contents simply replace the older ones
+                pending->contents = std::move(contents);
+                if (onWritten) pending->onWritten.push_back(std::move(onWritten));
+            } else {
+                SaveJob job{ filename, std::move(contents), {} };
+                if (onWritten) job.onWritten.push_back(std::move(onWritten));
+                queue.push_back(std::move(job));
+            }
+        }
+        wake.notify_one();
+    }
+
+    // Waits for the queue to drain; true if no write failed since the last flush
+    bool wait() {
+        std::unique_lock<std::mutex> lock(mutex);
+        idle.wait(lock, [this] { return queue.empty() && !busy; });
+        return !failed;
+    }
+
+    // Same as wait(), but also clears the failure once it has been reported
+    bool flush() {
+        std::unique_lock<std::mutex> lock(mutex);
+        idle.wait(lock, [this] { return queue.empty() && !busy; });
+        bool ok = !failed;
+        failed = false;
+        return ok;
+    }
+
+private:
+    void run() {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            wake.wait(lock, [this] { return stopping || !queue.empty(); });
+            if (queue.empty()) return; // stopping with nothing left to write
+
+            SaveJob job = std::move(queue.front());
+            queue.pop_front();
+            busy = true;
+            lock.unlock();
+
+            bool ok = writeFileAtomically(job.filename, job.contents);
+            if (ok) {
+                for (auto& callback : job.onWritten) callback();
+            }
+
+            lock.lock();
+            busy = false;
+            if (!ok) failed = true;
+            if (queue.empty()) idle.notify_all();
+        }
+    }
+};
+
+// Started on first use, stopped (after a final flush) when the program exits
+static PersistenceWorker& persistenceWorker() {
+    static PersistenceWorker instance;
+    return instance;
+}
+
+void requestSave(const std::string& filename, std::string contents, std::function<void()> onWritten) {
+    persistenceWorker().enqueue(filename, std::move(contents), std::move(onWritten));
+}
+
+bool flushPendingSaves() {
+    return persistenceWorker().flush();
+}
+
+bool waitForPendingSaves() {
+    return persistenceWorker().wait();
+}
@@ -0,0 +1,31 @@
+#ifndef PERSISTENCE_H
+#define PERSISTENCE_H
+
+#include <string>
+#include <functional>
+
+// Background writer for whole-file saves.
+// Callers serialize the data on their own thread and hand the bytes over; a
+// single worker thread writes them to "<file>.tmp", fsyncs, and renames it over
+// the target, so a crash leaves either the old or the new file, never half of one.
+// Saves of the same file that queue up before the worker reaches them are
+// coalesced into one write of the newest contents.
+
+// Queues contents to be written to filename. onWritten (optional) runs on the
+// worker thread once the new file is durably in place; it does not run if the write fails.
+void requestSave(const std::string& filename, std::string contents, std::function<void()> onWritten = nullptr);
+
+// Writes contents to "<filename>.tmp", fsyncs it, renames it over filename and
+// fsyncs the directory so the rename itself survives a crash. Runs on the
+// calling thread (the worker uses it for queued saves). Returns false on failure.
+bool writeFileAtomically(const std::string& filename, const std::string& contents);
+
+// Blocks until every queued save has been written. Returns false if any write
+// since the previous flush failed. Called on logout and before exiting.
+bool flushPendingSaves();
+
+// Blocks like flushPendingSaves, but leaves a failure in place so the next
+// flushPendingSaves still reports it. For internal waits (e.g. journal compaction).
+bool waitForPendingSaves();
+
+#endif  // PERSISTENCE_H
@@ -1,6 +1,9 @@
 #include "Pet.h"
 #include "validations.h"
 #include "globals.h"
+#include "journal.h"
+#include <chrono>
+#include <iomanip>
 void addNewPet() {
     while (true) {
         std::string ownerIdStr;
@@ -87,13 +90,21 @@ void addNewPet() {
                 petId = nextPetId;
                 Pet pet(petId, name, breed, age, ownerId);
                 pets.push_back(pet);
-                saveAllPetsToFile(pets);
+                petIndex.insert(petId, pets.size() - 1);
+                petNames.assign(petId, { name, breed });
+                fuzzyPets.index(pets.back());
+                indexVaccinationStatuses(pets.back());
+                journalPet(pets.back());
                 nextPetId++;
                 petAlreadySaved = true;
 
                 newOwner.addPetId(petId);
                 owners.push_back(newOwner);
-                saveAllOwnersToFile(owners);
+                ownerIndex.insert(ownerId, owners.size() - 1);
+                ownerContacts.add(owners.back());
+                ownerNames.assign(ownerId, { owner_name });
+                fuzzyOwners.index(owners.back());
+                journalOwner(owners.back());
                 nextOwnerId++;
 
                 std::cout << "✅ Owner created with ID " << ownerId << " and pet linked.\n";
@@ -132,14 +143,19 @@ void addNewPet() {
             petId = nextPetId;
             Pet pet(petId, name, breed, age, ownerId);
             pets.push_back(pet);
-            saveAllPetsToFile(pets);
+            petIndex.insert(petId, pets.size() - 1);
+            petNames.assign(petId, { name, breed });
+            fuzzyPets.index(pets.back());
+            indexVaccinationStatuses(pets.back());
+            if (ownerId == -1) unassignedPetIds.insert(petId);
+            journalPet(pets.back());
             nextPetId++;
 
             if (ownerId != -1) {
                 for (auto& o : owners) {
                     if (o.getOwnerId() == ownerId) {
                         o.addPetId(petId);
-                        saveAllOwnersToFile(owners);
+                        journalOwner(o);
                         break;
                     }
                 }
@@ -179,11 +195,9 @@ void viewPetDetailsById() {
         int id = askForValidId("🔎 Enter Pet 🆔 to view details (or press Enter/0 to return): ");
         if (id == 0) break;
 
-        auto it = std::find_if(pets.begin(), pets.end(), [&](const Pet& p) {
-            return p.getPetId() == id;
-        });
+        const Pet* it = findPetById(pets, id);
 
-        if (it == pets.end()) {
+        if (!it) {
             std::cout << "❌ Pet with ID " << id << " not found. Please try again.\n";
             continue;
         }
@@ -299,22 +313,31 @@ void updatePet() {
         // Apply updates if confirmed
         pet->setName(newName);
         pet->setBreed(newBreed);
+        petNames.assign(petId, { newName, newBreed });
+        fuzzyPets.index(*pet);
         pet->setAge(newAgeTemp);
 
         if (ownerChanged) {
             if (currentOwnerId != -1) {
                 Owner* oldOwner = findOwnerById(owners, currentOwnerId);
-                if (oldOwner) oldOwner->removePetId(petId);
+                if (oldOwner) {
+                    oldOwner->removePetId(petId);
+                    journalOwner(*oldOwner);
+                }
             }
             if (finalOwnerId != -1) {
                 Owner* newOwner = findOwnerById(owners, finalOwnerId);
-                if (newOwner) newOwner->addPetId(petId);
+                if (newOwner) {
+                    newOwner->addPetId(petId);
+                    journalOwner(*newOwner);
+                }
             }
             pet->setOwnerId(finalOwnerId);
-            saveAllOwnersToFile(owners);
+            if (finalOwnerId == -1) unassignedPetIds.insert(petId);
+            else unassignedPetIds.erase(petId);
         }
 
-        saveAllPetsToFile(pets);
+        journalPet(*pet);
         std::cout << "✅ Pet updated successfully.\n";
         break; // Exit loop after successful update
     }
@@ -344,33 +367,27 @@ void manageMedicalRecords() {
                     int id = askForValidId("Enter Pet 🆔 to add medical record (or press Enter or '0' to return): ");
                     if (id == 0) break;
                     
-                    bool found = false;
-                    
-                    for (auto& p : pets) {
-                        if (p.getPetId() == id) {
-                            found = true;
-                            std::string date = askForValidDate("Enter the date (YYYY-MM-DD) (or press Enter/0 to return): ", false, true);
-                            if (date.empty() || date == "0") {
-                                std::cout << "❌ Record creation cancelled.\n";
-                                break;
-                            }
-                            std::string details = askForValidDetails("Enter the details (max 200 characters) (or press Enter/0 to return): ", 200, true);
-                            if (details.empty() || details == "0") {
-                                std::cout << "❌ Record creation cancelled.\n";
-                                break;
-                            }
-                            p.addMedicalHistory(date, details);
-                            saveAllPetsToFile(pets);
-                            std::cout << "✅ Medical record added successfully.\n";
-
-                            addMore = promptYesNo("🔁 Would you like to add another record for another pet?");
-                            break;
-                        }
+                    Pet* pet = findPetById(pets, id);
+                    if (!pet) {
+                        std::cout << "❌ Pet 🆔 " << id << " not found. Please try again.\n";
+                        continue;
                     }
 
-                    if (!found) {
-                        std::cout << "❌ Pet 🆔 " << id << " not found. Please try again.\n";
+                    std::string date = askForValidDate("Enter the date (YYYY-MM-DD) (or press Enter/0 to return): ", false, true);
+                    if (date.empty() || date == "0") {
+                        std::cout << "❌ Record creation cancelled.\n";
+                        continue;
                     }
+                    std::string details = askForValidDetails("Enter the details (max 200 characters) (or press Enter/0 to return): ", 200, true);
+                    if (details.empty() || details == "0") {
+                        std::cout << "❌ Record creation cancelled.\n";
+                        continue;
+                    }
+                    pet->addMedicalHistory(date, details);
+                    journalPet(*pet);
+                    std::cout << "✅ Medical record added successfully.\n";
+
+                    addMore = promptYesNo("🔁 Would you like to add another record for another pet?");
                 }
 
                 break;
@@ -458,7 +475,7 @@ void manageMedicalRecords() {
                         std::string finalDetails = newDetails.empty() ? currentRecord.getDetails() : newDetails;
 
                         pet->updateMedicalHistory(recId, finalDate, finalDetails);
-                        saveAllPetsToFile(pets);
+                        journalPet(*pet);
                         std::cout << "✅ Medical record updated successfully.\n";
 
                         if (promptYesNo("🔁 Would you like to update another record for the same pet?")) {
@@ -503,7 +520,7 @@ void manageMedicalRecords() {
 
                         if (promptYesNo("⚠️ Are you sure you want to delete this record?")) {
                             pet->removeMedicalHistory(recId);
-                            saveAllPetsToFile(pets);
+                            journalPet(*pet);
                             std::cout << "✅ Medical record deleted successfully.\n";
 
                             if (pet->hasMedicalHistory()) {
@@ -575,7 +592,7 @@ void manageGeneralRecords() {
                     }
 
                     pet->addPetRecord(date, details);
-                    saveAllPetsToFile(pets);
+                    journalPet(*pet);
                     std::cout << "✅ General record added successfully.\n";
 
                     addMore = promptYesNo("🔁 Would you like to add another record for another pet?");
@@ -589,25 +606,21 @@ void manageGeneralRecords() {
                     int id = askForValidId("Enter Pet 🆔 to view general records (or press Enter/0 to return): ");
                     if (id == 0) break;
                     
-                    bool found = false;
-                    for (auto& p : pets) {
-                        if (p.getPetId() == id) {
-                            found = true;
-                            if (p.hasRecords(p.getPetRecords())) {
-                                p.displayRecordTable(p.getPetRecords(), "General Pet Records");
+                    const Pet* pet = findPetById(pets, id);
+                    if (!pet) {
+                        std::cout << "❌ Pet 🆔 " << id << " not found. Please try again.\n";
+                        continue;
+                    }
 
-                                if (promptYesNo("📋 Would you like to view full details of any record?")) {
-                                    int recId = askForValidId("Enter the Record 🆔 to view full details: ");
-                                    displayFullRecord(p.getPetRecords(), recId, "General Record");
-                                }
-                            } else {
-                                std::cout << "📭 No general records found for Pet 🆔 " << id << ".\n";
-                            }
-                            break;
+                    if (pet->hasRecords(pet->getPetRecords())) {
+                        pet->displayRecordTable(pet->getPetRecords(), "General Pet Records");
+
+                        if (promptYesNo("📋 Would you like to view full details of any record?")) {
+                            int recId = askForValidId("Enter the Record 🆔 to view full details: ");
+                            displayFullRecord(pet->getPetRecords(), recId, "General Record");
                         }
-                    }
-                    if (!found) {
-                        std::cout << "❌ Pet 🆔 " << id << " not found. Please try again.\n";
+                    } else {
+                        std::cout << "📭 No general records found for Pet 🆔 " << id << ".\n";
                     }
                 }
                 break;
@@ -657,7 +670,7 @@ void manageGeneralRecords() {
                         if (!newDate.empty()) pet->updatePetRecordDate(recId, newDate);
                         if (!newDetails.empty()) pet->updatePetRecordDetails(recId, newDetails);
 
-                        saveAllPetsToFile(pets);
+                        journalPet(*pet);
                         std::cout << "✅ General record updated successfully.\n";
 
                         if (promptYesNo("🔁 Would you like to update another record for the same pet?")) {
@@ -702,7 +715,7 @@ void manageGeneralRecords() {
 
                         if (promptYesNo("⚠️ Are you sure you want to delete this record?")) {
                             pet->removePetRecord(recId);
-                            saveAllPetsToFile(pets);
+                            journalPet(*pet);
                             std::cout << "✅ General record deleted successfully.\n";
 
                             if (pet->hasRecords(pet->getPetRecords())) {
@@ -733,6 +746,72 @@ void manageGeneralRecords() {
 }
 
 
+// Outstanding vaccinations whose due date could not be read have no place in the
+// due-soon table, so they are listed on their own
+static void listUndatedVaccinations() {
+    std::vector<DueVaccination> undated = vaccinationQueue.undated();
+    if (undated.empty()) return;
+
+    std::cout << "\n❓ " << undated.size() << " pending vaccination(s) with an unknown due date:\n";
+    for (const auto& d : undated) {
+        const Pet* pet = findPetById(pets, d.petId);
+        const Vaccination* v = pet ? pet->getVaccinationById(d.vaccinationId) : nullptr;
+        if (!v) continue;
+
+        std::cout << std::left
+                  << std::setw(26) << "   unknown due date"
+                  << std::setw(8)  << d.petId
+                  << std::setw(18) << truncateDetails(pet->getName(), 16)
+                  << std::setw(22) << truncateDetails(v->getName(), 20)
+                  << v->getStatus() << "\n";
+    }
+}
+
+void viewVaccinationsDueSoon() {
+    int days = askForMenuChoice(1, 365, "📅 Show vaccinations due within how many days? (1-365): ");
+
+    Date today = Date::today();
+    std::vector<DueVaccination> due = vaccinationQueue.dueBy(today.plusDays(days));
+    if (due.empty()) {
+        std::cout << "✅ No pending vaccinations or boosters due in the next " << days << " day(s).\n";
+        listUndatedVaccinations();
+        return;
+    }
+
+    std::cout << "\n⏰ Vaccinations due within " << days << " day(s), overdue first:\n";
+    std::cout << std::left
+              << std::setw(12) << "Due"
+              << std::setw(14) << "When"
+              << std::setw(8)  << "Pet ID"
+              << std::setw(18) << "Pet"
+              << std::setw(22) << "Vaccine"
+              << "Status\n";
+    std::cout << std::string(92, '-') << "\n";
+
+    size_t overdue = 0;
+    for (const auto& d : due) {
+        const Pet* pet = findPetById(pets, d.petId);
+        const Vaccination* v = pet ? pet->getVaccinationById(d.vaccinationId) : nullptr;
+        if (!v) continue;
+
+        int inDays = d.dueDate.daysSinceEpoch() - today.daysSinceEpoch();
+        std::string when = inDays < 0 ? "overdue " + std::to_string(-inDays) + "d"
+                         : inDays == 0 ? "today" : "in " + std::to_string(inDays) + "d";
+        if (inDays < 0) overdue++;
+
+        std::cout << std::left
+                  << std::setw(12) << d.dueDate
+                  << std::setw(14) << when
+                  << std::setw(8)  << d.petId
+                  << std::setw(18) << truncateDetails(pet->getName(), 16)
+                  << std::setw(22) << truncateDetails(v->getName(), 20)
+                  << v->getStatus() << "\n";
+    }
+    std::cout << std::string(92, '-') << "\n";
+    std::cout << "📊 " << due.size() << " vaccination(s) due, " << overdue << " of them overdue.\n";
+    listUndatedVaccinations();
+}
+
 void manageVaccinations() {
     // manage vaccinations
     while (true) {
@@ -742,8 +821,9 @@ void manageVaccinations() {
         std::cout << "3. ✏️  Update Vaccination Status (By Pet 🆔 & Vaccination Name)\n";  
         std::cout << "4. 🗑️  Delete Vaccination (By Pet 🆔 & Vaccination 🆔)\n";  
         std::cout << "5. 📋 View Overall Vaccination Status (By Pet 🆔)\n";  
+        std::cout << "6. ⏰ Vaccinations Due Soon (All Pets)\n";
         std::cout << "0. 🔙 Return to Pet Menu\n";
-        int choice_m = askForMenuChoice(0, 5);
+        int choice_m = askForMenuChoice(0, 6);
         if (choice_m == 0) break;
 
         switch (choice_m)
@@ -765,7 +845,8 @@ void manageVaccinations() {
                     continue;
                 }
 
-                std::string date = askForValidDate("Enter the date (YYYY-MM-DD) (or press Enter/0 to return): ", false, true);
+                // a vaccination not given yet is dated when it is due, which may be ahead
+                std::string date = askForValidDate("Enter the date given, or the due date if not given yet (YYYY-MM-DD) (or press Enter/0 to return): ", true, true);
                 if (date.empty() || date == "0") {
                     std::cout << "❌ Vaccination creation cancelled.\n";
                     continue;
@@ -778,7 +859,10 @@ void manageVaccinations() {
                 }
 
                 pet->addVaccination(name, date, status);
-                saveAllPetsToFile(pets);
+                fuzzyPets.index(*pet);
+                vaccinationQueue.update(*pet);
+                indexVaccinationStatuses(*pet);
+                journalPet(*pet);
                 std::cout << "✅ Vaccination added successfully.\n";
 
                 if (!promptYesNo("🔁 Would you like to add another vaccination for another pet?")) break;
@@ -852,7 +936,7 @@ void manageVaccinations() {
                     std::cout << "\n✏️ Updating vaccination: " << v->getName() << " (🆔: " << v->getId() << ")\n";
                     std::cout << "📅 Current date: " << v->getDate() << " | 📌 Status: " << v->getStatus() << "\n";
 
-                    std::string newDate = askForUpdatedDate("Enter new date (YYYY-MM-DD) (Enter to keep, 0 to cancel): ", false);
+                    std::string newDate = askForUpdatedDate("Enter new date given or due (YYYY-MM-DD) (Enter to keep, 0 to cancel): ", true);
                     if (newDate == "0") {
                         std::cout << "❌ Update cancelled.\n";
                         break;
@@ -867,7 +951,9 @@ void manageVaccinations() {
                     if (!newDate.empty() || !newStatus.empty()) {
                         pet->updateVaccination(vaccId, newDate.empty() ? v->getDate() : newDate,
                                                         newStatus.empty() ? v->getStatus() : newStatus);
-                        saveAllPetsToFile(pets);
+                        vaccinationQueue.update(*pet);
+                        indexVaccinationStatuses(*pet);
+                        journalPet(*pet);
                         std::cout << "✅ Vaccination updated successfully.\n";
                     } else {
                         std::cout << "⚠️ No changes made.\n";
@@ -916,7 +1002,10 @@ void manageVaccinations() {
 
                     if (promptYesNo("⚠️ Are you sure you want to delete this vaccination?")) {
                         pet->removeVaccination(vaccId);
-                        saveAllPetsToFile(pets);
+                        fuzzyPets.index(*pet);
+                        vaccinationQueue.update(*pet);
+                        indexVaccinationStatuses(*pet);
+                        journalPet(*pet);
                         std::cout << "✅ Vaccination deleted successfully.\n";
 
                         if (pet->hasVaccinations()) {
@@ -969,6 +1058,9 @@ void manageVaccinations() {
 
             std::cout << "🔙 Returning to Manage Vaccinations Menu...\n";
             break;
+        case 6:
+            viewVaccinationsDueSoon();
+            break;
         }
     }
 
@@ -1014,7 +1106,7 @@ void manageAppointments()
                         continue;
                     }
 
-                    std::string time = askForValidAppointmentTime("Enter appointment time (HH:MM) (or press Enter/0 to return): ", true);
+                    std::string time = askForFreeAppointmentTime(date, "Enter appointment time (HH:MM) (or press Enter/0 to return): ", true);
                     if (time.empty()) {
                         std::cout << "❌ Appointment creation cancelled.\n";
                         continue;
@@ -1030,7 +1122,8 @@ void manageAppointments()
                     std::string status = "scheduled";
 
                     appointments.emplace_back(appointmentId, ownerId, id, date, time, purpose, status);
-                    saveAllAppointmentsToFile(appointments);
+                    appointmentIndex.add(appointments.back(), appointments.size() - 1);
+                    journalAppointment(appointments.back());
 
                     std::cout << "✅ Appointment (🆔 " << appointmentId << ") added successfully.\n";
 
@@ -1051,12 +1144,7 @@ void manageAppointments()
                         continue;
                     }
 
-                    std::vector<Appointment> petAppointments;
-                    for (const auto& appt : appointments) {
-                        if (appt.getPetId() == id) {
-                            petAppointments.push_back(appt);
-                        }
-                    }
+                    AppointmentView petAppointments = appointmentIndex.forPet(appointments, id);
 
                     if (petAppointments.empty()) {
                         std::cout << "📭 No appointments found for 🐾 " << pet->getName() << " (🆔 " << id << ").\n";
@@ -1070,10 +1158,10 @@ void manageAppointments()
                                 if (apptId == 0) break;
 
                                 auto it = std::find_if(petAppointments.begin(), petAppointments.end(),
-                                    [apptId](const Appointment& a) { return a.getAppointmentId() == apptId; });
+                                    [apptId](const Appointment* a) { return a->getAppointmentId() == apptId; });
 
                                 if (it != petAppointments.end()) {
-                                    it->displayAppointmentDetails();
+                                    (*it)->displayAppointmentDetails();
                                 } else {
                                     std::cout << "❌ Appointment 🆔 " << apptId << " not found for this pet.\n";
                                 }
@@ -1096,12 +1184,7 @@ void manageAppointments()
                         continue;
                     }
 
-                    std::vector<Appointment> petAppts;
-                    for (const auto& appt : appointments) {
-                        if (appt.getPetId() == id) {
-                            petAppts.push_back(appt);
-                        }
-                    }
+                    AppointmentView petAppts = appointmentIndex.forPet(appointments, id);
 
                     if (petAppts.empty()) {
                         std::cout << "📭 No appointments found for 🐾 " << pet->getName() << " (🆔 " << id << ").\n";
@@ -1116,11 +1199,11 @@ void manageAppointments()
                         if (apptId == 0) break;
 
                         auto it = std::find_if(petAppts.begin(), petAppts.end(),
-                            [apptId](const Appointment& a) { return a.getAppointmentId() == apptId; });
+                            [apptId](const Appointment* a) { return a->getAppointmentId() == apptId; });
 
                         if (it != petAppts.end()) {
                             std::cout << "🔁 You are updating the following appointment:\n";
-                            it->displayFullAppointment();
+                            (*it)->displayFullAppointment();
 
                             std::string newStatus = askForValidAppointmentStatus("Enter a new status (or Enter/0 to return)");
                             if (newStatus.empty()) {
@@ -1128,12 +1211,12 @@ void manageAppointments()
                                 break;
                             }
 
-                            auto mainIt = std::find_if(appointments.begin(), appointments.end(),
-                                [apptId](const Appointment& a) { return a.getAppointmentId() == apptId; });
+                            Appointment* appt = findAppointmentById(appointments, apptId);
 
-                            if (mainIt != appointments.end()) {
-                                mainIt->updateStatus(newStatus);
-                                saveAllAppointmentsToFile(appointments);
+                            if (appt) {
+                                appt->updateStatus(newStatus);
+                                appointmentIndex.update(*appt);
+                                journalAppointment(*appt);
 
                                 std::cout << "✅ Appointment (🆔 " << apptId << ") status updated successfully.\n";
 
@@ -1141,12 +1224,7 @@ void manageAppointments()
                                     break;
                                 }
 
-                                petAppts.clear();
-                                for (const auto& appt : appointments) {
-                                    if (appt.getPetId() == id) {
-                                        petAppts.push_back(appt);
-                                    }
-                                }
+                                petAppts = appointmentIndex.forPet(appointments, id);
 
                                 std::cout << "\n📅 Updated Appointments for Pet: " << pet->getName() << "\n";
                                 Appointment::displayAppointmentsTable(petAppts);
@@ -1189,27 +1267,43 @@ void deletePet()
 
             std::cout << "⚠️ This will also delete all appointments and unlink from owners.\n";
             if (promptYesNo("⚠️ Are you sure you want to delete this pet from the entire system?")) {
+                std::vector<int> petAppointmentIds = pet->getAppointmentIds();
+
                 // remove pets from pets vector
                 pets.erase(std::remove_if(pets.begin(), pets.end(), 
                             [id](const Pet& p) {return p.getPetId() == id;}),
                             pets.end());
+                petIndex.rebuild(pets);   // later pets shifted down a slot
+                petNames.remove(id);
+                fuzzyPets.remove(id);
+                vaccinationQueue.remove(id);
+                petVaccinationStatus.remove(id);
+                vaccinationStatuses.remove(id);
+                unassignedPetIds.erase(id);
+
+                journalPetRemoval(id);
 
                 // remove appointments
+                for (int appointmentId : petAppointmentIds) {
+                    journalAppointmentRemoval(appointmentId);
+                }
                 appointments.erase(std::remove_if(appointments.begin(), appointments.end(),
                                     [id](const Appointment& a) {return a.getPetId() == id;}),
                                     appointments.end());
+                appointmentIndex.rebuild(appointments);
+                textIndex.removeEntity(RecordSource::MedicalHistory, id);
+                textIndex.removeEntity(RecordSource::PetRecord, id);
 
                 // remove pet id from owners
                 for (auto& owner : owners) {
                     auto& petIds = owner.getPetIdsRef();
-                    petIds.erase(std::remove(petIds.begin(), petIds.end(), id), petIds.end());
+                    auto linked = std::remove(petIds.begin(), petIds.end(), id);
+                    if (linked != petIds.end()) {
+                        petIds.erase(linked, petIds.end());
+                        journalOwner(owner);
+                    }
                 }
 
-                // save
-                saveAllPetsToFile(pets);
-                saveAllOwnersToFile(owners);
-                saveAllAppointmentsToFile(appointments);
-
                 std::cout << "✅ Pet and all associated records deleted successfully.\n";
 
                 if (!promptYesNo("🔁 Would you like to delete another pet?")) {
@@ -1232,8 +1326,7 @@ void deletePet()
 void linkPetToOwner() {
     displayUnassignedPets(pets);
 
-    bool hasUnassigned = std::any_of(pets.begin(), pets.end(), [](const Pet& p) { return p.getOnwerId() == -1; });
-    if (!hasUnassigned) {
+    if (unassignedPetIds.empty()) {
         std::cout << "📭 No unassigned pets found. 🔙 Returning to Pet Menu...\n";
         return;
     }
@@ -1266,8 +1359,8 @@ void linkPetToOwner() {
                 break;  // Exit owner selection, back to pet selection
             }
 
-            auto ownerIt = std::find_if(owners.begin(), owners.end(), [ownerId](const Owner& o) { return o.getOwnerId() == ownerId; });
-            if (ownerIt == owners.end()) {
+            Owner* owner = findOwnerById(owners, ownerId);
+            if (!owner) {
                 std::cout << "❌ Owner 🆔 not found. Please try again.\n";
                 continue;  // Re-prompt for owner ID
             }
@@ -1276,13 +1369,14 @@ void linkPetToOwner() {
 
             std::cout << "\n🔗 You're about to link:\n";
             std::cout << "🐾 Pet: " << pet->getName() << " (🆔 " << petId << ")\n";
-            std::cout << "👤 Owner: " << ownerIt->getName() << " (🆔 " << ownerId << ")\n";
+            std::cout << "👤 Owner: " << owner->getName() << " (🆔 " << ownerId << ")\n";
 
             if (promptYesNo("⚠️ Are you sure you want to link this pet to the selected owner?")) {
                 pet->setOwnerId(ownerId);
-                ownerIt->addPetId(petId);
-                saveAllPetsToFile(pets);
-                saveAllOwnersToFile(owners);
+                unassignedPetIds.erase(petId);
+                owner->addPetId(petId);
+                journalPet(*pet);
+                journalOwner(*owner);
                 std::cout << "✅ Pet successfully linked to owner.\n";
 
                 if (!promptYesNo("🔁 Would you like to link another unassigned pet?")) {
@@ -1300,3 +1394,131 @@ void linkPetToOwner() {
     std::cout << "🔙 Returning to Pet Menu...\n";
 }
 
+
+// Looks up the record behind a search hit; nullptr if it has gone
+static const Record* recordForHit(const TextHit& hit, std::string& name) {
+    const RecordMap* records = nullptr;
+    if (hit.source == RecordSource::OwnerRecord) {
+        const Owner* owner = findOwnerById(owners, hit.entityId);
+        if (!owner) return nullptr;
+        name = owner->getName();
+        records = &owner->getRecords();
+    } else {
+        const Pet* pet = findPetById(pets, hit.entityId);
+        if (!pet) return nullptr;
+        name = pet->getName();
+        records = hit.source == RecordSource::MedicalHistory ? &pet->getMedicalHistory() : &pet->getPetRecords();
+    }
+    auto it = records->find(hit.recordId);
+    return it == records->end() ? nullptr : &it->second;
+}
+
+void searchRecords(bool includeMedicalHistory) {
+    if (!textIndex.isBuilt()) {
+        std::cout << "⏳ Building search index...\n";
+        textIndex.build(pets, owners);
+        std::cout << "✅ Indexed " << textIndex.documentCount() << " records (" << textIndex.termCount() << " distinct words).\n";
+    }
+
+    while (true) {
+        std::cout << "\n🔎 Words must all match; use OR for alternatives and \"quotes\" for phrases.\n";
+        std::cout << "🔎 Enter search terms (or press Enter/0 to return): ";
+        std::string query;
+        std::getline(std::cin, query);
+        query = trim(query);
+        if (query.empty() || query == "0") break;
+
+        auto start = std::chrono::steady_clock::now();
+        std::vector<TextHit> hits = textIndex.search(query, 20, includeMedicalHistory);
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        if (hits.empty()) {
+            std::cout << "📭 No matching records found.\n";
+        } else {
+            std::cout << std::left
+                      << std::setw(8)  << "Score"
+                      << std::setw(10) << "Type"
+                      << std::setw(8)  << "ID"
+                      << std::setw(20) << "Pet/Owner"
+                      << std::setw(8)  << "Rec ID"
+                      << std::setw(12) << "Date"
+                      << "Details\n";
+            std::cout << std::string(106, '-') << "\n";
+
+            for (const auto& hit : hits) {
+                std::string name;
+                const Record* record = recordForHit(hit, name);
+                if (!record) continue;
+
+                const char* type = hit.source == RecordSource::MedicalHistory ? "Medical"
+                                 : hit.source == RecordSource::PetRecord ? "Pet" : "Owner";
+                std::cout << std::left << std::fixed << std::setprecision(2)
+                          << std::setw(8)  << hit.score
+                          << std::setw(10) << type
+                          << std::setw(8)  << hit.entityId
+                          << std::setw(20) << truncateDetails(name, 18)
+                          << std::setw(8)  << hit.recordId
+                          << std::setw(12) << record->getDate()
+                          << truncateDetails(record->getDetails(), 40) << "\n";
+            }
+            std::cout << std::string(106, '-') << "\n";
+            std::cout.unsetf(std::ios::fixed);
+            std::cout << "📊 Showing " << hits.size() << " best match(es), found in " << std::setprecision(3) << ms << " ms.\n";
+            std::cout << std::setprecision(6);
+        }
+
+        if (!promptYesNo("🔁 Would you like to search again?")) break;
+    }
+}
+
+void searchPetsByName() {
+    while (true) {
+        std::cout << "\n🔎 Enter the start of a pet name or breed (or press Enter/0 to return): ";
+        std::string prefix;
+        std::getline(std::cin, prefix);
+        prefix = trim(prefix);
+        if (prefix.empty() || prefix == "0") break;
+
+        auto start = std::chrono::steady_clock::now();
+        std::vector<int> ids = petNames.findPrefix(prefix, 20);
+        std::vector<FuzzyMatch> close;
+        if (ids.empty()) close = fuzzyPets.search(prefix, 10);   // maybe a typo
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        if (ids.empty() && close.empty()) {
+            std::cout << "📭 No pets match \"" << prefix << "\".\n";
+        } else if (ids.empty()) {
+            std::cout << "🤔 No names start with \"" << prefix << "\". Closest matches:\n";
+            std::cout << std::left
+                      << std::setw(8)  << "Match"
+                      << std::setw(8)  << "Pet ID"
+                      << std::setw(20) << "Name"
+                      << std::setw(20) << "Breed"
+                      << "Matched On\n";
+            std::cout << std::string(80, '-') << "\n";
+            for (const auto& m : close) {
+                const Pet* p = findPetById(pets, m.id);
+                if (!p) continue;
+                std::cout << std::left
+                          << std::setw(8)  << (std::to_string(static_cast<int>(m.similarity * 100 + 0.5)) + "%")
+                          << std::setw(8)  << p->getPetId()
+                          << std::setw(20) << truncateDetails(p->getName(), 18)
+                          << std::setw(20) << truncateDetails(p->getBreed(), 18)
+                          << m.matched << "\n";
+            }
+            std::cout << std::string(80, '-') << "\n";
+            std::cout << "📊 Showing " << close.size() << " close match(es), found in " << std::setprecision(3) << ms << " ms.\n";
+            std::cout << std::setprecision(6);
+        } else {
+            displayPetTableHeader();
+            for (int id : ids) {
+                if (const Pet* p = findPetById(pets, id)) p->displayAsTableRow(owners);
+            }
+            std::cout << "--------------------------------------------------------------------------\n";
+            std::cout << "📊 Showing " << ids.size() << " match(es), found in " << std::setprecision(3) << ms << " ms.\n";
+            std::cout << std::setprecision(6);
+        }
+
+        if (!promptYesNo("🔁 Would you like to search again?")) break;
+    }
+}
@@ -23,6 +23,9 @@ void manageGeneralRecords();
 // Allows veterinarians to update or review vaccination records for a pet.
 void manageVaccinations();
 
+// Lists outstanding vaccinations and boosters due within a chosen number of days, overdue ones included.
+void viewVaccinationsDueSoon();
+
 // Displays and manages appointments associated with a specific pet.
 void manageAppointments();
 
@@ -34,5 +37,13 @@ void linkPetToOwner();
 // updates an existing pet data
 void updatePet();
 
+// Full-text search across pet medical history, pet records and owner records.
+// Medical history is only searched if includeMedicalHistory is set.
+void searchRecords(bool includeMedicalHistory);
+
+// Lists pets whose name or breed has a word starting with the typed text,
+// or the closest names (typos allowed) if none does
+void searchPetsByName();
+
 
 #endif  // pet_helper
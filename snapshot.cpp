@@ -0,0 +1,472 @@
+#include "snapshot.h"
+#include "globals.h"
+#include "mapped_file.h"
+#include "validations.h"
+#include "persistence.h"
+#include <iostream>
+#include <cstring>
+#include <algorithm>
+#include <unordered_map>
+#include <filesystem>
+
+// One section per column. New sections may only be appended; changing the
+// meaning of an existing one requires a new SNAPSHOT_VERSION.
+enum SnapshotSection : uint32_t {
+    SEC_STRING_HEAP,
+
+    SEC_USER_ID, SEC_USER_NAME, SEC_USER_PASSWORD, SEC_USER_ROLE,
+
+    SEC_PET_ID, SEC_PET_NAME, SEC_PET_BREED, SEC_PET_AGE, SEC_PET_OWNER,
+    SEC_PET_VACC_START, SEC_PET_MED_START, SEC_PET_REC_START,   // rows + 1 range starts
+    SEC_VACC_ID, SEC_VACC_NAME, SEC_VACC_DATE, SEC_VACC_STATUS,
+    SEC_RECORD_ID, SEC_RECORD_DATE, SEC_RECORD_DETAILS,         // shared by pets and owners
+
+    SEC_OWNER_ID, SEC_OWNER_NAME, SEC_OWNER_ADDRESS, SEC_OWNER_PHONE, SEC_OWNER_EMAIL,
+    SEC_OWNER_PET_START, SEC_OWNER_REC_START,                   // rows + 1 range starts
+    SEC_OWNER_PET_ID,
+
+    SEC_APPT_ID, SEC_APPT_OWNER, SEC_APPT_PET, SEC_APPT_DATE, SEC_APPT_TIME,
+    SEC_APPT_PURPOSE, SEC_APPT_STATUS,
+
+    SEC_UNPARSED_TEXT,
+
+    SECTION_COUNT
+};
+
+const char SNAPSHOT_MAGIC[8] = { 'V', 'E', 'T', 'S', 'N', 'A', 'P', '\0' };
+const uint32_t SNAPSHOT_BYTE_ORDER = 0x01020304;   // rejects files written on a machine of other endianness
+
+struct SnapshotHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrder;
+    uint32_t sectionCount;
+    uint32_t reserved;
+};
+
+struct SectionEntry {
+    uint32_t id;
+    uint32_t elementSize;
+    uint64_t offset;      // from the start of the file, 8-byte aligned
+    uint64_t count;       // number of elements
+};
+
+// A string stored in the heap section
+struct StrRef {
+    uint32_t offset;
+    uint32_t length;
+};
+
+// Date columns hold int32 days since the epoch and the time column uint16 minutes
+// since midnight. A date or time whose text did not parse is stored as the
+// invalid value, with its original text kept here so it round-trips unchanged.
+struct UnparsedText {
+    uint32_t section;
+    uint32_t row;
+    StrRef text;
+};
+
+// The CSV files a snapshot must be newer than to be used
+static const char* const CSV_FILES[] = { "users.csv", "pets.csv", "owners.csv", "appointments.csv" };
+
+
+// ===== Writing =====
+
+class SnapshotWriter {
+    std::vector<std::string> columns = std::vector<std::string>(SECTION_COUNT);
+    uint32_t elementSizes[SECTION_COUNT] = {};
+
+public:
+    template <typename T>
+    void push(SnapshotSection section, const T& value) {
+        elementSizes[section] = sizeof(T);
+        columns[section].append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    void pushInt(SnapshotSection section, int value) {
+        push(section, static_cast<int32_t>(value));
+    }
+
+    void pushString(SnapshotSection section, std::string_view text) {
+        push(section, storeString(text));
+    }
+
+    // Packed date of a row (anything with getDateValue() and getDate())
+    template <typename Row>
+    void pushDate(SnapshotSection section, const Row& row) {
+        Date value = row.getDateValue();
+        if (!value.valid()) pushUnparsed(section, row.getDate());
+        push(section, value.daysSinceEpoch());
+    }
+
+    // Packed time of a row (anything with getTimeValue() and getTime())
+    template <typename Row>
+    void pushTime(SnapshotSection section, const Row& row) {
+        TimeOfDay value = row.getTimeValue();
+        if (!value.valid()) pushUnparsed(section, row.getTime());
+        push(section, static_cast<uint16_t>(value.minutesSinceMidnight()));
+    }
+
+    // Current number of elements in a column, used for range starts
+    uint32_t count(SnapshotSection section) const {
+        return elementSizes[section] ? static_cast<uint32_t>(columns[section].size() / elementSizes[section]) : 0;
+    }
+
+private:
+    StrRef storeString(std::string_view text) {
+        std::string& heap = columns[SEC_STRING_HEAP];
+        StrRef ref{ static_cast<uint32_t>(heap.size()), static_cast<uint32_t>(text.size()) };
+        heap += text;
+        return ref;
+    }
+
+    // Keeps the text of the next row of a date/time column, if there is any
+    void pushUnparsed(SnapshotSection section, const std::string& text) {
+        if (text.empty()) return;
+        push(SEC_UNPARSED_TEXT, UnparsedText{ section, count(section), storeString(text) });
+    }
+
+public:
+    bool write(const std::string& filename) {
+        elementSizes[SEC_STRING_HEAP] = 1;
+
+        std::vector<SectionEntry> table(SECTION_COUNT);
+        uint64_t offset = sizeof(SnapshotHeader) + sizeof(SectionEntry) * SECTION_COUNT;
+        for (uint32_t s = 0; s < SECTION_COUNT; ++s) {
+            offset = (offset + 7) & ~uint64_t(7);
+            table[s] = { s, elementSizes[s], offset, count(static_cast<SnapshotSection>(s)) };
+            offset += columns[s].size();
+        }
+
+        SnapshotHeader header;
+        std::memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+        header.version = SNAPSHOT_VERSION;
+        header.byteOrder = SNAPSHOT_BYTE_ORDER;
+        header.sectionCount = SECTION_COUNT;
+        header.reserved = 0;
+
+        std::string contents;
+        contents.reserve(offset);
+        contents.append(reinterpret_cast<const char*>(&header), sizeof(header));
+        contents.append(reinterpret_cast<const char*>(table.data()), sizeof(SectionEntry) * table.size());
+        for (uint32_t s = 0; s < SECTION_COUNT; ++s) {
+            contents.resize(table[s].offset, '\0');
+            contents += columns[s];
+        }
+
+        // replace the old snapshot only once the new one is complete and on disk
+        return writeFileAtomically(filename, contents);
+    }
+};
+
+// Appends a record map to the shared record columns
+static void pushRecords(SnapshotWriter& writer, const RecordMap& records) {
+    for (const auto& [id, record] : records) {
+        writer.pushInt(SEC_RECORD_ID, id);
+        writer.pushDate(SEC_RECORD_DATE, record);
+        writer.pushString(SEC_RECORD_DETAILS, record.getDetails());
+    }
+}
+
+bool writeSnapshot(const std::string& filename) {
+    SnapshotWriter writer;
+
+    for (const auto& u : users) {
+        writer.pushInt(SEC_USER_ID, u->getId());
+        writer.pushString(SEC_USER_NAME, u->getUsername());
+        writer.pushString(SEC_USER_PASSWORD, u->getPassword());
+        writer.pushString(SEC_USER_ROLE, u->getRole());
+    }
+
+    for (const auto& p : pets) {
+        writer.pushInt(SEC_PET_ID, p.getPetId());
+        writer.pushString(SEC_PET_NAME, p.getName());
+        writer.pushString(SEC_PET_BREED, p.getBreed());
+        writer.pushInt(SEC_PET_AGE, p.getAge());
+        writer.pushInt(SEC_PET_OWNER, p.getOnwerId());
+
+        writer.push(SEC_PET_VACC_START, writer.count(SEC_VACC_ID));
+        for (const auto& v : p.getVaccinations()) {
+            writer.pushInt(SEC_VACC_ID, v.getId());
+            writer.pushString(SEC_VACC_NAME, v.getName());
+            writer.pushDate(SEC_VACC_DATE, v);
+            writer.pushString(SEC_VACC_STATUS, v.getStatus());
+        }
+    }
+    // closing entry, so row i spans [start[i], start[i + 1])
+    writer.push(SEC_PET_VACC_START, writer.count(SEC_VACC_ID));
+
+    // each kind of record is written in its own pass to keep every range contiguous
+    for (const auto& p : pets) {
+        writer.push(SEC_PET_MED_START, writer.count(SEC_RECORD_ID));
+        pushRecords(writer, p.getMedicalHistory());
+    }
+    writer.push(SEC_PET_MED_START, writer.count(SEC_RECORD_ID));
+
+    for (const auto& p : pets) {
+        writer.push(SEC_PET_REC_START, writer.count(SEC_RECORD_ID));
+        pushRecords(writer, p.getPetRecords());
+    }
+    writer.push(SEC_PET_REC_START, writer.count(SEC_RECORD_ID));
+
+    for (const auto& o : owners) {
+        writer.pushInt(SEC_OWNER_ID, o.getOwnerId());
+        writer.pushString(SEC_OWNER_NAME, o.getName());
+        writer.pushString(SEC_OWNER_ADDRESS, o.getAddress());
+        writer.pushString(SEC_OWNER_PHONE, o.getPhoneNumber());
+        writer.pushString(SEC_OWNER_EMAIL, o.getEmail());
+
+        writer.push(SEC_OWNER_PET_START, writer.count(SEC_OWNER_PET_ID));
+        for (int petId : o.getPetIds()) writer.pushInt(SEC_OWNER_PET_ID, petId);
+    }
+    writer.push(SEC_OWNER_PET_START, writer.count(SEC_OWNER_PET_ID));
+
+    for (const auto& o : owners) {
+        writer.push(SEC_OWNER_REC_START, writer.count(SEC_RECORD_ID));
+        pushRecords(writer, o.getRecords());
+    }
+    writer.push(SEC_OWNER_REC_START, writer.count(SEC_RECORD_ID));
+
+    for (const auto& a : appointments) {
+        writer.pushInt(SEC_APPT_ID, a.getAppointmentId());
+        writer.pushInt(SEC_APPT_OWNER, a.getOwnerId());
+        writer.pushInt(SEC_APPT_PET, a.getPetId());
+        writer.pushDate(SEC_APPT_DATE, a);
+        writer.pushTime(SEC_APPT_TIME, a);
+        writer.pushString(SEC_APPT_PURPOSE, a.getPurpose());
+        writer.pushString(SEC_APPT_STATUS, a.getStatus());
+    }
+
+    return writer.write(filename);
+}
+
+
+// ===== Reading =====
+
+// Bounds-checked access to the sections of a mapped snapshot. Any out-of-range
+// access clears `valid` and yields empty values, so the caller checks once at the end.
+class SnapshotReader {
+    std::string_view bytes;
+    const SectionEntry* table = nullptr;
+    std::unordered_map<uint64_t, std::string_view> unparsed;   // (section, row) -> original text
+
+    static uint64_t unparsedKey(uint32_t section, uint64_t row) {
+        return (uint64_t(section) << 32) | row;
+    }
+
+public:
+    bool valid = false;
+
+    explicit SnapshotReader(std::string_view bytes) : bytes(bytes) {
+        if (bytes.size() < sizeof(SnapshotHeader)) return;
+        const auto* header = reinterpret_cast<const SnapshotHeader*>(bytes.data());
+        if (std::memcmp(header->magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0) return;
+        if (header->version != SNAPSHOT_VERSION || header->byteOrder != SNAPSHOT_BYTE_ORDER) return;
+        if (header->sectionCount != SECTION_COUNT) return;
+        if (bytes.size() < sizeof(SnapshotHeader) + sizeof(SectionEntry) * SECTION_COUNT) return;
+
+        table = reinterpret_cast<const SectionEntry*>(bytes.data() + sizeof(SnapshotHeader));
+        for (uint32_t s = 0; s < SECTION_COUNT; ++s) {
+            const SectionEntry& entry = table[s];
+            if (entry.id != s || entry.offset % 8 != 0 || entry.offset > bytes.size()) return;
+            if (entry.elementSize != 0 && entry.count > (bytes.size() - entry.offset) / entry.elementSize) return;
+            if (entry.elementSize == 0 && entry.count != 0) return;
+        }
+        valid = true;
+
+        size_t unparsedCount = count(SEC_UNPARSED_TEXT);
+        for (size_t i = 0; i < unparsedCount && valid; ++i) {
+            UnparsedText entry = at<UnparsedText>(SEC_UNPARSED_TEXT, i);
+            unparsed[unparsedKey(entry.section, entry.row)] = viewOf(entry.text);
+        }
+    }
+
+    // Number of elements in a column
+    size_t count(SnapshotSection section) const {
+        return valid ? table[section].count : 0;
+    }
+
+    // Element i of a fixed-width column
+    template <typename T>
+    T at(SnapshotSection section, size_t i) {
+        if (!valid || table[section].elementSize != sizeof(T) || i >= table[section].count) {
+            valid = false;
+            return T{};
+        }
+        return reinterpret_cast<const T*>(bytes.data() + table[section].offset)[i];
+    }
+
+    int intAt(SnapshotSection section, size_t i) {
+        return at<int32_t>(section, i);
+    }
+
+    // Bytes of a heap string, pointing into the mapping (valid while the file is open)
+    std::string_view viewOf(StrRef ref) {
+        const SectionEntry& heap = table[SEC_STRING_HEAP];
+        if (!valid || uint64_t(ref.offset) + ref.length > heap.count) {
+            valid = false;
+            return std::string_view();
+        }
+        return std::string_view(bytes.data() + heap.offset + ref.offset, ref.length);
+    }
+
+    std::string_view viewAt(SnapshotSection section, size_t i) {
+        return viewOf(at<StrRef>(section, i));
+    }
+
+    StoredDate dateAt(SnapshotSection section, size_t i) {
+        int32_t days = at<int32_t>(section, i);
+        if (days != Date::INVALID_DAYS) return StoredDate(Date::fromDays(days));
+        return StoredDate(unparsedText(section, i));
+    }
+
+    StoredTime timeAt(SnapshotSection section, size_t i) {
+        TimeOfDay time = TimeOfDay::fromMinutes(at<uint16_t>(section, i));
+        if (time.valid()) return StoredTime(time);
+        return StoredTime(unparsedText(section, i));
+    }
+
+    // Original text of an invalid date/time, "" if none was stored
+    std::string_view unparsedText(SnapshotSection section, size_t i) {
+        auto it = unparsed.find(unparsedKey(section, i));
+        return it != unparsed.end() ? it->second : std::string_view();
+    }
+
+    // Range of child rows [begin, end) for parent row i, checked against the child column
+    bool range(SnapshotSection starts, size_t i, SnapshotSection child, size_t& begin, size_t& end) {
+        begin = at<uint32_t>(starts, i);
+        end = at<uint32_t>(starts, i + 1);
+        if (!valid || begin > end || end > count(child)) valid = false;
+        return valid;
+    }
+};
+
+// Builds a user of the stored role, nullptr for an unknown role
+static std::unique_ptr<User> makeUser(int id, std::string_view username, std::string_view password, std::string_view role) {
+    std::string lowerRole = toLower(std::string(role));
+    if (lowerRole == "admin") return std::make_unique<Admin>(id, std::string(username), std::string(password));
+    if (lowerRole == "staff") return std::make_unique<Staff>(id, std::string(username), std::string(password));
+    if (lowerRole == "veterinarian") return std::make_unique<Veterinarian>(id, std::string(username), std::string(password));
+    return nullptr;
+}
+
+bool snapshotIsFresh(const std::string& filename) {
+    std::error_code ec;
+    auto snapshotTime = std::filesystem::last_write_time(filename, ec);
+    if (ec) return false;
+
+    for (const char* csv : CSV_FILES) {
+        auto csvTime = std::filesystem::last_write_time(csv, ec);
+        if (!ec && csvTime >= snapshotTime) return false;
+    }
+    return true;
+}
+
+bool loadSnapshot(const std::string& filename) {
+    MappedFile file(filename);
+    if (!file.isOpen()) return false;
+
+    SnapshotReader reader(file.view());
+    if (!reader.valid) {
+        std::cerr << "⚠️ " << filename << " is not a valid version " << SNAPSHOT_VERSION
+                  << " snapshot, loading the CSV files instead.\n";
+        return false;
+    }
+
+    std::vector<std::unique_ptr<User>> loadedUsers;
+    std::vector<Pet> loadedPets;
+    std::vector<Owner> loadedOwners;
+    std::vector<Appointment> loadedAppointments;
+    int highestUserId = 0, highestPetId = 0, highestOwnerId = 0, highestAppointmentId = 0;
+
+    size_t userCount = reader.count(SEC_USER_ID);
+    loadedUsers.reserve(userCount);
+    for (size_t i = 0; i < userCount && reader.valid; ++i) {
+        int id = reader.intAt(SEC_USER_ID, i);
+        auto user = makeUser(id, reader.viewAt(SEC_USER_NAME, i),
+                             reader.viewAt(SEC_USER_PASSWORD, i), reader.viewAt(SEC_USER_ROLE, i));
+        if (!user) reader.valid = false;
+        else loadedUsers.push_back(std::move(user));
+        highestUserId = std::max(highestUserId, id);
+    }
+
+    size_t petCount = reader.count(SEC_PET_ID);
+    loadedPets.reserve(petCount);
+    for (size_t i = 0; i < petCount && reader.valid; ++i) {
+        Pet pet(reader.intAt(SEC_PET_ID, i), std::string(reader.viewAt(SEC_PET_NAME, i)),
+                std::string(reader.viewAt(SEC_PET_BREED, i)),
+                reader.intAt(SEC_PET_AGE, i), reader.intAt(SEC_PET_OWNER, i));
+
+        size_t begin, end;
+        if (reader.range(SEC_PET_VACC_START, i, SEC_VACC_ID, begin, end)) {
+            for (size_t v = begin; v < end; ++v) {
+                pet.addVaccinationWithId(reader.intAt(SEC_VACC_ID, v), reader.viewAt(SEC_VACC_NAME, v),
+                                         reader.dateAt(SEC_VACC_DATE, v), reader.viewAt(SEC_VACC_STATUS, v));
+            }
+        }
+        if (reader.range(SEC_PET_MED_START, i, SEC_RECORD_ID, begin, end)) {
+            for (size_t r = begin; r < end; ++r) {
+                pet.addMedicalHistoryWithId(reader.intAt(SEC_RECORD_ID, r), reader.dateAt(SEC_RECORD_DATE, r),
+                                            reader.viewAt(SEC_RECORD_DETAILS, r));
+            }
+        }
+        if (reader.range(SEC_PET_REC_START, i, SEC_RECORD_ID, begin, end)) {
+            for (size_t r = begin; r < end; ++r) {
+                pet.addPetRecordWithId(reader.intAt(SEC_RECORD_ID, r), reader.dateAt(SEC_RECORD_DATE, r),
+                                       reader.viewAt(SEC_RECORD_DETAILS, r));
+            }
+        }
+
+        highestPetId = std::max(highestPetId, pet.getPetId());
+        loadedPets.push_back(std::move(pet));
+    }
+
+    size_t ownerCount = reader.count(SEC_OWNER_ID);
+    loadedOwners.reserve(ownerCount);
+    for (size_t i = 0; i < ownerCount && reader.valid; ++i) {
+        Owner owner(reader.intAt(SEC_OWNER_ID, i), std::string(reader.viewAt(SEC_OWNER_NAME, i)),
+                    std::string(reader.viewAt(SEC_OWNER_ADDRESS, i)), std::string(reader.viewAt(SEC_OWNER_PHONE, i)),
+                    std::string(reader.viewAt(SEC_OWNER_EMAIL, i)));
+
+        size_t begin, end;
+        if (reader.range(SEC_OWNER_PET_START, i, SEC_OWNER_PET_ID, begin, end)) {
+            for (size_t p = begin; p < end; ++p) owner.addPetId(reader.intAt(SEC_OWNER_PET_ID, p));
+        }
+        if (reader.range(SEC_OWNER_REC_START, i, SEC_RECORD_ID, begin, end)) {
+            for (size_t r = begin; r < end; ++r) {
+                owner.addRecordWithId(reader.intAt(SEC_RECORD_ID, r), reader.dateAt(SEC_RECORD_DATE, r),
+                                      reader.viewAt(SEC_RECORD_DETAILS, r));
+            }
+        }
+
+        highestOwnerId = std::max(highestOwnerId, owner.getOwnerId());
+        loadedOwners.push_back(std::move(owner));
+    }
+
+    size_t appointmentCount = reader.count(SEC_APPT_ID);
+    loadedAppointments.reserve(appointmentCount);
+    for (size_t i = 0; i < appointmentCount && reader.valid; ++i) {
+        int id = reader.intAt(SEC_APPT_ID, i);
+        loadedAppointments.emplace_back(id, reader.intAt(SEC_APPT_OWNER, i), reader.intAt(SEC_APPT_PET, i),
+                                        reader.dateAt(SEC_APPT_DATE, i), reader.timeAt(SEC_APPT_TIME, i),
+                                        std::string(reader.viewAt(SEC_APPT_PURPOSE, i)),
+                                        reader.viewAt(SEC_APPT_STATUS, i));
+        highestAppointmentId = std::max(highestAppointmentId, id);
+    }
+
+    if (!reader.valid) {
+        std::cerr << "⚠️ " << filename << " is damaged, loading the CSV files instead.\n";
+        return false;
+    }
+
+    users = std::move(loadedUsers);
+    usernameIndex.rebuild(users);
+    pets = std::move(loadedPets);
+    owners = std::move(loadedOwners);
+    appointments = std::move(loadedAppointments);
+    nextUserId = std::max(nextUserId, highestUserId + 1);
+    nextPetId = std::max(nextPetId, highestPetId + 1);
+    nextOwnerId = std::max(nextOwnerId, highestOwnerId + 1);
+    nextAppointmentId = std::max(nextAppointmentId, highestAppointmentId + 1);
+    return true;
+}
@@ -0,0 +1,31 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <string>
+#include <cstdint>
+
+// Versioned binary snapshot of all in-memory data (users, pets, owners, appointments).
+// Layout: a fixed header, a section table, then one section per column. Numeric
+// columns are fixed-width arrays, dates and times included (packed days and
+// minutes); string columns hold {offset, length} references into a shared string
+// heap. Loading maps the file and reads values straight out of the columns, with
+// no text parsing; strings are copied only into fields that own a std::string.
+// The CSV files stay the interchange format, the snapshot is only a fast startup path.
+
+const std::string SNAPSHOT_FILE = "vet_data.snapshot";
+const uint32_t SNAPSHOT_VERSION = 2;
+
+// Writes the current in-memory data to a snapshot file with writeFileAtomically()
+// (temporary file, fsync, rename).
+// Returns false if the file could not be written.
+bool writeSnapshot(const std::string& filename);
+
+// True if the snapshot exists and is newer than every CSV data file
+bool snapshotIsFresh(const std::string& filename);
+
+// Replaces users, pets, owners and appointments with the snapshot contents, rebuilds
+// the username index and syncs the next ID counters. Returns false, leaving the data untouched, if the file is
+// missing, written by another version, or damaged.
+bool loadSnapshot(const std::string& filename);
+
+#endif  // SNAPSHOT_H
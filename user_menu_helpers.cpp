@@ -5,6 +5,8 @@
 #include <fstream>
 #include <iomanip>
 #include "hashing.h"
+#include "persistence.h"
+#include <sstream>
 
 extern std::unique_ptr<User> createUser(int id, const std::string& username, const std::string& rawPassword, const std::string& role);
 
@@ -52,15 +54,7 @@ void addNewUser(std::vector<std::unique_ptr<User>>& users, int& nextUserId) {
             break;
         }
 
-        bool userNameExists = false;
-        for (const auto& user : users) {
-            if (user->getUsername() == username) {
-                userNameExists = true;
-                break;
-            }
-        }
-
-        if (userNameExists) {
+        if (usernameIndex.find(username)) {
             std::cout << "❌ A user with that username already exists. Please choose another.\n";
             continue;
         }
@@ -107,6 +101,7 @@ void addNewUser(std::vector<std::unique_ptr<User>>& users, int& nextUserId) {
         }
 
         // users.emplace_back(std::make_unique<Admin>(nextUserId, username, hashedPassword));
+        usernameIndex.add(users.back().get());
 
         nextUserId++;
         saveAllUsersToFile(users);
@@ -141,15 +136,9 @@ void updateUser(std::vector<std::unique_ptr<User>>& users) {
             std::cout << "Update cancelled.\n";
             continue; // Back to User ID
         }
-        if (!newUsernameTemp.empty() && newUsernameTemp != user->getUsername()) {
-            bool usernameExists = false;
-            for (const auto& u : users) {
-                if (u->getUsername() == newUsernameTemp && u->getId() != user->getId()) {
-                    usernameExists = true;
-                    break;
-                }
-            }
-            if (usernameExists) {
+        if (!newUsernameTemp.empty()) {
+            User* holder = usernameIndex.find(newUsernameTemp);
+            if (holder && holder != user) {
                 std::cout << "❌ That username is already taken. Try a different one.\n";
                 continue;
             }
@@ -186,6 +175,7 @@ void updateUser(std::vector<std::unique_ptr<User>>& users) {
             if (users[index]->getId() == id) break;
         }
 
+        usernameIndex.remove(user);   // re-added below under the final name
         if (lowerOldRole != lowerNewRole) {
             if (lowerNewRole == "admin") {
                 users[index] = std::make_unique<Admin>(id, finalUsername, finalPassword);
@@ -195,12 +185,14 @@ void updateUser(std::vector<std::unique_ptr<User>>& users) {
                 users[index] = std::make_unique<Veterinarian>(id, finalUsername, finalPassword);
             } else {
                 std::cout << "❌ Unknown role. Update aborted.\n";
+                usernameIndex.add(user);
                 continue;
             }
         } else {
             user->setUsername(finalUsername);
             user->setPassword(finalPassword);
         }
+        usernameIndex.add(users[index].get());
 
         saveAllUsersToFile(users);
         std::cout << "✅ User updated successfully.\n";
@@ -229,6 +221,7 @@ void deleteUser(std::vector<std::unique_ptr<User>>& users) {
         user->displayUserInfo();
 
         if (promptYesNo("\nAre you sure you want to delete this user?")) {
+            usernameIndex.remove(user);
             users.erase(std::remove_if(users.begin(), users.end(),
                 [id](const std::unique_ptr<User>& u) { return u->getId() == id; }),
                 users.end());
@@ -246,15 +239,10 @@ void deleteUser(std::vector<std::unique_ptr<User>>& users) {
 }
 
 void saveAllUsersToFile(const std::vector<std::unique_ptr<User>>& users) {
-    std::ofstream file("users.csv");
-    if (!file) {
-        std::cerr << "Could not open users.csv for writing.\n";
-        return;
-    }
-
+    std::ostringstream file;
     file << "user_id,username,password,role\n";
     for (const auto& u : users) {
         u->saveToFile(file);
     }
-    file.close();
+    requestSave("users.csv", file.str());
 }
\ No newline at end of file
@@ -17,7 +17,7 @@ void updateUser(std::vector<std::unique_ptr<User>>& users);
 // Deletes a user from the system based on their ID.
 void deleteUser(std::vector<std::unique_ptr<User>>& users);
 
-// Saves all user data to a CSV file for persistence.
+// Serializes all user data and queues it for the background writer (users.csv).
 void saveAllUsersToFile(const std::vector<std::unique_ptr<User>>& users);
 
 #endif  // USER_MENU_HELPERS_H
@@ -1,4 +1,6 @@
 #include "validations.h"
+#include "globals.h"
+#include "SlotFinder.h"
 #include <iostream>
 #include <regex>
 #include <cstdlib>
@@ -143,17 +145,50 @@ std::string askForValidVaccinationStatus(const std::string& prompt) {
 }
 
 
-Pet* findPetById(std::vector<Pet>& pets, int id) { 
-    for (auto& p : pets) { 
-        if (p.getPetId() == id) { 
-            return &p; 
-        } 
-    } 
-    return nullptr; 
+const Pet* findPetById(const std::vector<Pet>& pets, int id) {
+    // The global pet list is indexed; check the slot still holds the pet and
+    // rebuild if something changed the vector without updating the index
+    if (&pets == &::pets) {
+        size_t slot = petIndex.find(id);
+        if (slot < pets.size() && pets[slot].getPetId() == id) {
+            return &pets[slot];
+        }
+        if (slot == PetIndex::NOT_FOUND && petIndex.size() == pets.size()) {
+            return nullptr;
+        }
+        petIndex.rebuild(pets);
+        slot = petIndex.find(id);
+        return slot == PetIndex::NOT_FOUND ? nullptr : &pets[slot];
+    }
+
+    for (const auto& p : pets) {
+        if (p.getPetId() == id) {
+            return &p;
+        }
+    }
+    return nullptr;
 }
 
-Owner* findOwnerById(std::vector<Owner>& owners, int id) {
-    for (auto& o : owners) {
+Pet* findPetById(std::vector<Pet>& pets, int id) {
+    return const_cast<Pet*>(findPetById(static_cast<const std::vector<Pet>&>(pets), id));
+}
+
+const Owner* findOwnerById(const std::vector<Owner>& owners, int id) {
+    // Same scheme as findPetById, over ownerIndex
+    if (&owners == &::owners) {
+        size_t slot = ownerIndex.find(id);
+        if (slot < owners.size() && owners[slot].getOwnerId() == id) {
+            return &owners[slot];
+        }
+        if (slot == OwnerIndex::NOT_FOUND && ownerIndex.size() == owners.size()) {
+            return nullptr;
+        }
+        ownerIndex.rebuild(owners);
+        slot = ownerIndex.find(id);
+        return slot == OwnerIndex::NOT_FOUND ? nullptr : &owners[slot];
+    }
+
+    for (const auto& o : owners) {
         if (o.getOwnerId() == id) {
             return &o;
         }
@@ -161,6 +196,10 @@ Owner* findOwnerById(std::vector<Owner>& owners, int id) {
     return nullptr;
 }
 
+Owner* findOwnerById(std::vector<Owner>& owners, int id) {
+    return const_cast<Owner*>(findOwnerById(static_cast<const std::vector<Owner>&>(owners), id));
+}
+
 
 int askForValidIntId(const std::string& prompt) {
     std::string idStr;
@@ -217,6 +256,16 @@ int askForValidAge(const std::string& prompt, bool allowCancel) {
 }
 
 
+std::string normalizeKey(std::string_view value) {
+    size_t start = 0, end = value.size();
+    while (start < end && std::isspace(static_cast<unsigned char>(value[start]))) start++;
+    while (end > start && std::isspace(static_cast<unsigned char>(value[end - 1]))) end--;
+
+    std::string key(value.substr(start, end - start));
+    for (char& c : key) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    return key;
+}
+
 std::string toLower(const std::string& str) {
     std::string lowerStr = str;
     std::transform(lowerStr.begin(), lowerStr.end(), lowerStr.begin(),
@@ -370,25 +419,13 @@ bool isValidDate(int day, int month, int year, bool allowFuture) {
 
 
 bool isFutureDate(int year, int month, int day) {
-    // check ??????
-    time_t now = time(0);
-    tm* localTime = localtime(&now);
-    int currentYear = 1900 + localTime->tm_year;
-    int currentMonth = 1 + localTime->tm_mon;
-    int currentDay = localTime->tm_mday;
-
-    if (year > currentYear) return true;
-    if (year == currentYear && month > currentMonth) return true;
-    if (year == currentYear && month == currentMonth && day > currentDay) return true;
-
-    return false;
+    return Date::fromCivil(year, month, day) > Date::today();
 }
 
 
 
 std::string askForValidDate(const std::string& prompt, bool allowFuture, bool allowCancel) {
     std::string date;
-    std::regex date_pattern(R"(^\d{4}-\d{2}-\d{2}$)");
     while (true) {
         std::cout << prompt;
         std::getline(std::cin, date);
@@ -398,15 +435,12 @@ std::string askForValidDate(const std::string& prompt, bool allowFuture, bool al
             return "";
         }
 
-        if (!std::regex_match(date, date_pattern)) {
+        int year, month, day;
+        if (!Date::parseFields(date, year, month, day)) {
             std::cout << "Invalid format! Use YYYY-MM-DD.\n";
             continue;
         }
 
-        int year = std::stoi(date.substr(0, 4));
-        int month = std::stoi(date.substr(5, 2));
-        int day = std::stoi(date.substr(8, 2));
-
         if (!isValidDate(day, month, year, allowFuture)) {
             std::cout << "Invalid logical date or year out of allowed range.\n";
             continue;
@@ -466,7 +500,6 @@ std::string askForValidAddress(const std::string& prompt, bool allowCancel) {
 
 std::string askForValidTime(const std::string& prompt) {
     std::string time;
-    std::regex time_pattern(R"(^\d{2}:\d{2}$)");
     while (true) {
         std::cout << prompt;
         std::getline(std::cin, time);
@@ -477,14 +510,12 @@ std::string askForValidTime(const std::string& prompt) {
             continue;
         }
 
-        if (!std::regex_match(time, time_pattern)) {
+        int hour, minute;
+        if (!TimeOfDay::parseFields(time, hour, minute)) {
             std::cout << "Invalid format! Use HH:MM.\n";
             continue;
         }
 
-        int hour = std::stoi(time.substr(0, 2));
-        int minute = std::stoi(time.substr(3, 2));
-
         if (hour < 0 || hour > 23 || minute < 0 || minute > 59) {
             std::cout << "Invalid time values! Hours: 0-23, Minutes: 0-59.\n";
             continue;
@@ -627,28 +658,17 @@ int askForMenuChoice(int minOption, int maxOption, const std::string& prompt) {
 }
 
 bool isToday(int year, int month, int day) {
-    time_t now = time(0);
-    tm* localTime = localtime(&now);
-    int currentYear = 1900 + localTime->tm_year;
-    int currentMonth = 1 + localTime->tm_mon;
-    int currentDay = localTime->tm_mday;
-
-    return (year == currentYear && month == currentMonth && day == currentDay);
+    return Date::fromCivil(year, month, day) == Date::today();
 }
 
 
 bool isWeekend(int year, int month, int day) {
-    std::tm timeStruct = {};
-    timeStruct.tm_year = year - 1900;
-    timeStruct.tm_mon = month - 1;
-    timeStruct.tm_mday = day;
-    std::mktime(&timeStruct);
-    return (timeStruct.tm_wday == 0 || timeStruct.tm_wday == 6); // Sunday=0, Saturday=6
+    Date date = Date::fromCivil(year, month, day);
+    return date.valid() && date.isWeekend();
 }
 
 std::string askForValidAppointmentDate(const std::string& prompt, bool disallowWeekends, bool allowCancel) {
     std::string date;
-    std::regex date_pattern(R"(^\d{4}-\d{2}-\d{2}$)");
     while (true) {
         std::cout << prompt;
         std::getline(std::cin, date);
@@ -658,15 +678,12 @@ std::string askForValidAppointmentDate(const std::string& prompt, bool disallowW
             return ""; // Return empty string to signal cancellation
         }
 
-        if (!std::regex_match(date, date_pattern)) {
+        int year, month, day;
+        if (!Date::parseFields(date, year, month, day)) {
             std::cout << "Invalid format! Use YYYY-MM-DD.\n";
             continue;
         }
 
-        int year = std::stoi(date.substr(0, 4));
-        int month = std::stoi(date.substr(5, 2));
-        int day = std::stoi(date.substr(8, 2));
-
         if (!isValidDate(day, month, year, true)) {
             std::cout << "Invalid logical date or year out of range.\n";
             continue;
@@ -693,7 +710,6 @@ std::string askForValidAppointmentDate(const std::string& prompt, bool disallowW
 
 std::string askForValidAppointmentTime(const std::string& prompt, bool allowCancel) {
     std::string time;
-    std::regex time_pattern(R"(^\d{2}:\d{2}$)");
     while (true) {
         std::cout << prompt;
         std::getline(std::cin, time);
@@ -703,14 +719,12 @@ std::string askForValidAppointmentTime(const std::string& prompt, bool allowCanc
             return ""; // Return empty string to signal cancellation
         }
 
-        if (!std::regex_match(time, time_pattern)) {
+        int hour, minute;
+        if (!TimeOfDay::parseFields(time, hour, minute)) {
             std::cout << "Invalid format! Use HH:MM.\n";
             continue;
         }
 
-        int hour = std::stoi(time.substr(0, 2));
-        int minute = std::stoi(time.substr(3, 2));
-
         if (hour < 8 || hour > 20 || minute < 0 || minute > 59) {
             std::cout << "Appointments can only be scheduled between 08:00 and 20:00.\n";
             continue;
@@ -722,6 +736,36 @@ std::string askForValidAppointmentTime(const std::string& prompt, bool allowCanc
 
 
 
+bool reportAppointmentConflict(const std::string& date, const std::string& time, int ignoreId) {
+    int clash = appointmentIndex.conflictWith(date, time, ignoreId);
+    if (clash == AppointmentIndex::NO_CONFLICT) return false;
+
+    const Appointment* other = findAppointmentById(appointments, clash);
+    std::cout << "⚠️ " << date << " " << time << " overlaps appointment 🆔 " << clash;
+    if (other) std::cout << " at " << other->getTime();
+    std::cout << " (appointments last " << AppointmentIndex::APPOINTMENT_MINUTES << " minutes).\n";
+    return true;
+}
+
+std::string askForFreeAppointmentTime(const std::string& date, const std::string& prompt, bool allowCancel) {
+    while (true) {
+        std::string time = askForValidAppointmentTime(prompt, allowCancel);
+        if (time.empty() || !reportAppointmentConflict(date, time)) return time;
+
+        // only this day: the date has already been chosen
+        std::vector<FreeSlot> suggestions = findFreeSlots(appointmentIndex, date, 4, AppointmentIndex::APPOINTMENT_MINUTES, 1);
+        if (suggestions.empty()) {
+            std::cout << "📭 No free times left on " << date << ".\n";
+        } else {
+            std::cout << "💡 Next free times on " << date << ":";
+            for (const auto& slot : suggestions) std::cout << " " << slot.time;
+            std::cout << "\n";
+        }
+        std::cout << "Please choose another time.\n";
+    }
+}
+
+
 bool getNewDateWithCancel(std::string& newDate, const std::string& prompt, bool allowFuture) {
     std::string input;
     std::cout << prompt << "(or press Enter/0 to cancel): ";
@@ -735,10 +779,8 @@ bool getNewDateWithCancel(std::string& newDate, const std::string& prompt, bool
     // Now pass it to the original askForValidDate logic manually
     std::stringstream ss(input);
     ss >> input; // reuse the same trimmed input
-    if (std::regex_match(input, std::regex(R"(^\d{4}-\d{2}-\d{2}$)"))) {
-        int year = std::stoi(input.substr(0, 4));
-        int month = std::stoi(input.substr(5, 2));
-        int day = std::stoi(input.substr(8, 2));
+    int year, month, day;
+    if (Date::parseFields(input, year, month, day)) {
 
         if (!isValidDate(day, month, year, allowFuture)) return false;
         if (!allowFuture && isFutureDate(year, month, day)) return false;
@@ -875,7 +917,6 @@ std::string askForUpdatedEmail(const std::string& prompt) {
 }
 
 std::string askForUpdatedDate(const std::string& prompt, bool allowFuture) {
-    std::regex date_pattern(R"(^\d{4}-\d{2}-\d{2}$)");
     std::string date;
     while (true) {
         std::cout << prompt;
@@ -885,15 +926,12 @@ std::string askForUpdatedDate(const std::string& prompt, bool allowFuture) {
         if (date.empty()) return "";       // keep existing
         if (date == "0") return "0";       // cancel update
 
-        if (!std::regex_match(date, date_pattern)) {
+        int year, month, day;
+        if (!Date::parseFields(date, year, month, day)) {
             std::cout << "Invalid format! Use YYYY-MM-DD.\n";
             continue;
         }
 
-        int year = std::stoi(date.substr(0, 4));
-        int month = std::stoi(date.substr(5, 2));
-        int day = std::stoi(date.substr(8, 2));
-
         if (!isValidDate(day, month, year, allowFuture)) {
             std::cout << "Invalid logical date or year out of allowed range.\n";
             continue;
@@ -928,7 +966,6 @@ std::string askForUpdatedDetails(const std::string& prompt) {
 }
 
 std::string askForUpdatedAppointmentDate(const std::string& currentDate, bool allowFuture) {
-    std::regex date_pattern(R"(^\d{4}-\d{2}-\d{2}$)");
     std::string date;
 
     while (true) {
@@ -939,15 +976,12 @@ std::string askForUpdatedAppointmentDate(const std::string& currentDate, bool al
         if (date.empty()) return "";      // keep current
         if (date == "0") return "0";      // cancel
 
-        if (!std::regex_match(date, date_pattern)) {
+        int year, month, day;
+        if (!Date::parseFields(date, year, month, day)) {
             std::cout << "Invalid format! Use YYYY-MM-DD.\n";
             continue;
         }
 
-        int year = std::stoi(date.substr(0, 4));
-        int month = std::stoi(date.substr(5, 2));
-        int day = std::stoi(date.substr(8, 2));
-
         if (!isValidDate(day, month, year, allowFuture)) {
             std::cout << "Invalid date.\n";
             continue;
@@ -963,7 +997,6 @@ std::string askForUpdatedAppointmentDate(const std::string& currentDate, bool al
 }
 
 std::string askForUpdatedAppointmentTime(const std::string& currentTime) {
-    std::regex time_pattern(R"(^\d{2}:\d{2}$)");
     std::string time;
 
     while (true) {
@@ -974,14 +1007,12 @@ std::string askForUpdatedAppointmentTime(const std::string& currentTime) {
         if (time.empty()) return "";
         if (time == "0") return "0";
 
-        if (!std::regex_match(time, time_pattern)) {
+        int hour, minute;
+        if (!TimeOfDay::parseFields(time, hour, minute)) {
             std::cout << "Invalid format! Use HH:MM.\n";
             continue;
         }
 
-        int hour = std::stoi(time.substr(0, 2));
-        int minute = std::stoi(time.substr(3, 2));
-
         if (hour < 0 || hour > 23 || minute < 0 || minute > 59) {
             std::cout << "Invalid time.\n";
             continue;
@@ -1156,22 +1187,14 @@ std::string askForUpdatedVaccinationStatus(const std::string& currentStatus) {
 }
 
 
-bool isPhoneNumberTaken(const std::string& phone) {
-    for (const auto& o : owners) {
-        if (toLower(trim(o.getPhoneNumber())) == toLower(trim(phone))) {
-            return true;
-        }
-    }
-    return false;
+bool isPhoneNumberTaken(const std::string& phone, int exceptOwnerId) {
+    int ownerId = ownerContacts.ownerWithPhone(phone);
+    return ownerId != OwnerContactIndex::NO_OWNER && ownerId != exceptOwnerId;
 }
 
-bool isEmailTaken(const std::string& email) {
-    for (const auto& o : owners) {
-        if (toLower(trim(o.getEmail())) == toLower(trim(email))) {
-            return true;
-        }
-    }
-    return false;
+bool isEmailTaken(const std::string& email, int exceptOwnerId) {
+    int ownerId = ownerContacts.ownerWithEmail(email);
+    return ownerId != OwnerContactIndex::NO_OWNER && ownerId != exceptOwnerId;
 }
 
 
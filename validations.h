@@ -2,7 +2,9 @@
 #define VALIDATIONS_H
 
 #include <iostream>
+#include <string_view>
 #include "Pet.h"
+#include "AppointmentIndex.h"
 
 // ===== Basic Validations =====
 
@@ -36,6 +38,9 @@ std::string askForValidTime(const std::string& prompt);
 // Trims leading/trailing whitespace from a string
 std::string trim(const std::string& s);
 
+// Trimmed, lower-cased copy used as a lookup key (usernames, owner contacts)
+std::string normalizeKey(std::string_view value);
+
 // Prompts for a valid address string, optional cancel
 std::string askForValidAddress(const std::string& prompt, bool allowCancel = false);
 
@@ -72,11 +77,13 @@ std::string askForUpdatedVaccinationStatus(const std::string& currentStatus);
 
 // ===== Lookup Helpers =====
 
-// Finds a pet by ID from the pet vector
+// Finds a pet by ID from the pet vector (O(1) through petIndex for the global list)
 Pet* findPetById(std::vector<Pet>& pets, int id);
+const Pet* findPetById(const std::vector<Pet>& pets, int id);
 
-// Finds an owner by ID from the owner vector
+// Finds an owner by ID from the owner vector (O(1) through ownerIndex for the global list)
 Owner* findOwnerById(std::vector<Owner>& owners, int id);
+const Owner* findOwnerById(const std::vector<Owner>& owners, int id);
 
 // ===== Appointment Validation =====
 
@@ -97,6 +104,13 @@ std::string askForValidAppointmentDate(const std::string& prompt, bool disallowW
 // Prompts for valid appointment time, optional cancel
 std::string askForValidAppointmentTime(const std::string& prompt, bool allowCancel = true);
 
+// Prompts for an appointment time on the given date, re-asking while it overlaps
+// another booked appointment (see AppointmentIndex::conflictWith)
+std::string askForFreeAppointmentTime(const std::string& date, const std::string& prompt, bool allowCancel = true);
+
+// Prints which booked appointment a date/time would overlap; returns true if there is one
+bool reportAppointmentConflict(const std::string& date, const std::string& time, int ignoreId = AppointmentIndex::NO_CONFLICT);
+
 // Prompts for new date with cancel support (used in updates)
 bool getNewDateWithCancel(std::string& newDate, const std::string& prompt = "Enter new date (YYYY-MM-DD): ", bool allowFuture = false);
 
@@ -133,8 +147,10 @@ std::string getHiddenPassword(const std::string& prompt);
 // Utility to capitalize each word in a string
 std::string capitalizeWords(const std::string& input);
 
-bool isPhoneNumberTaken(const std::string& phone);
-bool isEmailTaken(const std::string& email);
+// True if another owner already uses this phone number / email (case and
+// surrounding spaces ignored). exceptOwnerId lets an owner keep their own.
+bool isPhoneNumberTaken(const std::string& phone, int exceptOwnerId = -1);
+bool isEmailTaken(const std::string& email, int exceptOwnerId = -1);
 std::string askForValidNameForUpdate(const std::string& prompt);
 int askForValidAgeForUpdate(const std::string& prompt);
 int askForOwnerIdOrOption(const std::string& prompt);